@@ -51,6 +51,27 @@ series.flush()
 # Compare arrays to check consistency between new BTD formats (plotfile and openPMD)
 assert np.allclose(Ez_plotfile, Ez_openpmd, rtol=rtol, atol=atol)
 
+# Read data from back-transformed diagnostics streamed from all ranks (openPMD)
+series_stream = io.Series("./diags/diag3/openpmd_%T.h5", io.Access.read_only)
+ds_stream = series_stream.iterations[3]
+Ez_stream = ds_stream.meshes["E"]["z"].load_chunk()
+beam_w_stream = ds_stream.particles["beam"]["weighting"][
+    io.Mesh_Record_Component.SCALAR
+].load_chunk()
+beam_z_stream = ds_stream.particles["beam"]["position"]["z"].load_chunk()
+series_stream.flush()
+Ez_stream = Ez_stream.transpose()
+# Compare arrays to check consistency between redistributed and streamed openPMD output
+assert np.allclose(Ez_openpmd, Ez_stream, rtol=rtol, atol=atol)
+
+# Check that all beam particles were appended without redistribution
+ad = ds_plotfile.all_data()
+beam_w_plotfile = ad[("beam", "particle_weight")].to_ndarray()
+beam_z_plotfile = ad[("beam", "particle_position_z")].to_ndarray()
+assert len(beam_w_stream) == len(beam_w_plotfile)
+assert np.isclose(np.sum(beam_w_stream), np.sum(beam_w_plotfile), rtol=1e-12)
+assert np.allclose(np.sort(beam_z_stream), np.sort(beam_z_plotfile), rtol=1e-12)
+
 # Check that particle random sub-selection has been applied
 ts = OpenPMDTimeSeries("./diags/diag2/")
 (w,) = ts.get_particle(["w"], species="beam", iteration=3)
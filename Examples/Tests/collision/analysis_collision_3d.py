@@ -111,5 +111,11 @@ post_processing_utils.check_random_filter(
     last_fn, random_filter_fn, random_fraction, dim, species_name
 )
 
+target_count_filter_fn = "diags/diag_target_count_filter" + last_it
+target_count = 1000
+post_processing_utils.check_target_count_filter(
+    last_fn, target_count_filter_fn, target_count, dim, species_name
+)
+
 test_name = os.path.split(os.getcwd())[1]
 checksumAPI.evaluate_checksum(test_name, last_fn)
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This script checks an option that must not change the result of a simulation,
+# e.g. the box-blocked FDTD push (warpx.do_fdtd_temporal_blocking = 1) or the
+# PSATD coefficients computed on the fly (psatd.on_the_fly_coefficients = 1):
+# the fields are compared with those of the same simulation run without the
+# option, in the directory of the base test, whose name is that of this test
+# without the suffix of the option (this test depends on the base test).
+
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+# suffixes of the tests names, for the options that are checked
+suffixes = ["_temporal_blocking", "_on_the_fly_coefficients"]
+
+# relative tolerance: the results only differ by the order of the operations
+tolerance = 1.0e-10
+
+fn = sys.argv[1]
+test_dir = os.getcwd()
+suffix = [s for s in suffixes if test_dir.endswith(s)]
+assert len(suffix) == 1
+fn_ref = os.path.join(test_dir[: -len(suffix[0])], fn)
+
+ds = yt.load(fn)
+ds_ref = yt.load(fn_ref)
+data = ds.covering_grid(
+    level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+)
+data_ref = ds_ref.covering_grid(
+    level=0, left_edge=ds_ref.domain_left_edge, dims=ds_ref.domain_dimensions
+)
+
+for field in ["Ex", "Ey", "Ez", "Bx", "By", "Bz", "jx", "jy", "jz"]:
+    F = data[("boxlib", field)].to_ndarray()
+    F_ref = data_ref[("boxlib", field)].to_ndarray()
+    error = np.amax(np.abs(F - F_ref)) / np.amax(np.abs(F_ref))
+    print(f"{field}: relative error = {error}")
+    assert error < tolerance
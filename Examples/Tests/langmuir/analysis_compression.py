@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This script checks the lossy compression of the output fields
+# (<diag>.compression.precision = single): the plotfile must be written with
+# 32-bit floats, and the fields must be within the single-precision rounding
+# error of those of the same simulation written without compression,
+# in the directory of the test without the "_compression" suffix (which this
+# test depends on).
+
+import glob
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+# relative rounding error of single precision
+eps_single = np.finfo(np.float32).eps
+
+fn = sys.argv[1]
+fn_ref = os.path.join(os.getcwd().replace("_compression", ""), fn)
+
+# the field data must be written in single precision
+for data_file in glob.glob(os.path.join(fn, "Level_0", "Cell_D_*")):
+    with open(data_file, "rb") as f:
+        header = f.readline().decode("ascii")
+    print(f"{data_file}: {header.strip()}")
+    assert header.startswith("FAB ((8, (32 ")
+
+ds = yt.load(fn)
+ds_ref = yt.load(fn_ref)
+data = ds.covering_grid(
+    level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+)
+data_ref = ds_ref.covering_grid(
+    level=0, left_edge=ds_ref.domain_left_edge, dims=ds_ref.domain_dimensions
+)
+
+for field in ["Ex", "Ey", "Ez", "Bx", "By", "Bz", "jx", "jy", "jz", "rho"]:
+    F = data[("boxlib", field)].to_ndarray()
+    F_ref = data_ref[("boxlib", field)].to_ndarray()
+    # rounding to single precision
+    bound = eps_single * np.abs(F_ref)
+    error = np.abs(F - F_ref)
+    ratio = np.divide(error, bound, out=np.zeros_like(error), where=bound > 0.0)
+    print(f"{field}: max error = {np.amax(error)}, max error / bound = {np.amax(ratio)}")
+    assert np.all(error <= bound)
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This script checks the region-of-interest field diagnostics:
+# - diag2 outputs a fixed region of interest, whose fields must be identical
+#   to the fields of the full diagnostics diag1 in the same region;
+# - diag3 outputs a region of interest that follows the centroid of the
+#   electrons, which stays at the center of the domain for this plasma wave.
+
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+fn = sys.argv[1]
+fn_roi = fn.replace("diag1", "diag2")
+fn_track = fn.replace("diag1", "diag3")
+
+ds = yt.load(fn)
+ds_roi = yt.load(fn_roi)
+ds_track = yt.load(fn_track)
+
+dx = ((ds.domain_right_edge - ds.domain_left_edge) / ds.domain_dimensions).v
+
+# Fields of the fixed region of interest
+data_roi = ds_roi.covering_grid(
+    level=0, left_edge=ds_roi.domain_left_edge, dims=ds_roi.domain_dimensions
+)
+# Same region extracted from the full diagnostics
+data = ds.covering_grid(
+    level=0, left_edge=ds_roi.domain_left_edge, dims=ds_roi.domain_dimensions
+)
+for field in ["Ex", "Ez", "jx", "jz", "rho"]:
+    F_roi = data_roi[("mesh", field)].to_ndarray()
+    F = data[("mesh", field)].to_ndarray()
+    print(field + " max difference: " + str(np.amax(np.abs(F_roi - F))))
+    assert np.array_equal(F_roi, F)
+
+# The tracking region of interest keeps its size and is re-centered on the electrons
+width_track = (ds_track.domain_right_edge - ds_track.domain_left_edge).v
+center_track = 0.5 * (ds_track.domain_left_edge + ds_track.domain_right_edge).v
+print("tracking region of interest center: " + str(center_track))
+assert np.all(np.abs(width_track[:2] - 10.0e-6) <= 1.01 * dx[:2])
+assert np.all(np.abs(center_track[:2]) <= 2.0 * dx[:2])
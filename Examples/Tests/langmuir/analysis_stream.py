@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This script checks the in-transit stream diagnostics: the messages published
+# by every rank in its shared-memory ring buffer are read after the run and
+# compared to the plotfile written at the same iteration.
+
+import sys
+
+import numpy as np
+import yt
+from read_stream import ShmRing
+
+yt.funcs.mylog.setLevel(0)
+
+fn = sys.argv[1]
+iteration = int(fn[-6:])
+nranks = 2
+
+ds = yt.load(fn)
+ad = ds.all_data()
+data = ds.covering_grid(
+    level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+)
+
+Ex = np.zeros(ds.domain_dimensions[:2])
+Ez = np.zeros(ds.domain_dimensions[:2])
+ids = []
+x = []
+ux = []
+iterations = []
+for rank in range(nranks):
+    ring = ShmRing("warpx_test_2d_langmuir_multi_stream_" + str(rank), timeout=1.0)
+    for message in ring.messages():
+        iterations.append(message["iteration"])
+        if message["iteration"] != iteration:
+            continue
+        assert message["rank"] == rank
+        for box in message["fields"][0]["boxes"]:
+            lo, hi = box["lo"], box["hi"]
+            Ex[lo[0] : hi[0] + 1, lo[1] : hi[1] + 1] = box["data"]["Ex"]
+            Ez[lo[0] : hi[0] + 1, lo[1] : hi[1] + 1] = box["data"]["Ez"]
+        electrons = message["particles"]["electrons"]
+        ids.append(electrons["id"] + 0.1 * electrons["cpu"])
+        x.append(electrons["x"])
+        ux.append(electrons["momentum_x"])
+    ring.unlink()
+
+# every rank publishes every snapshot
+print("streamed iterations: " + str(sorted(iterations)))
+assert sorted(iterations) == sorted(nranks * [0, 40, 80])
+
+# the streamed fields are identical to the plotfile fields
+for name, F in [("Ex", Ex), ("Ez", Ez)]:
+    F_plt = data[("boxlib", name)].to_ndarray()[:, :, 0]
+    print(name + " max difference: " + str(np.amax(np.abs(F - F_plt))))
+    assert np.array_equal(F, F_plt)
+
+# the streamed particles are the particles of the plotfile
+ids = np.concatenate(ids)
+x = np.concatenate(x)
+ux = np.concatenate(ux)
+ids_plt = (
+    ad["electrons", "particle_id"].to_ndarray()
+    + 0.1 * ad["electrons", "particle_cpu"].to_ndarray()
+)
+x_plt = ad["electrons", "particle_position_x"].to_ndarray()
+ux_plt = ad["electrons", "particle_momentum_x"].to_ndarray()
+assert np.array_equal(np.sort(ids), np.sort(ids_plt))
+assert np.array_equal(x[np.argsort(ids)], x_plt[np.argsort(ids_plt)])
+
+# the streamed momenta are in SI units (kg.m/s), as in the plotfile,
+# and not the WarpX units (gamma*v, in m/s)
+print("max streamed momentum_x: " + str(np.amax(np.abs(ux))))
+assert np.amax(np.abs(ux)) < 1.0e-15
+assert np.array_equal(ux[np.argsort(ids)], ux_plt[np.argsort(ids_plt)])
@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# -*- coding: utf-8 -*-
+
+import filecmp
+import os
+import sys
+
+import yt
+
+sys.path.insert(1, "../../../../warpx/Regression/Checksum/")
+import analysis_breit_wheeler_core as ac
+
+# This script checks the generation of the QED lookup tables with
+# warpx.do_task_parallel_init = 1, where the Quantum Synchrotron and the
+# Breit-Wheeler tables are generated concurrently by two groups of MPI ranks:
+# the tables must be identical to those generated one after the other by the
+# I/O processor, in the directory of the test without the
+# "_task_parallel_init" suffix (which this test depends on), and the
+# Breit-Wheeler process must be correct with these tables
+# (see analysis_breit_wheeler_core.py).
+
+
+def main():
+    ref_dir = os.getcwd().replace("_task_parallel_init", "")
+    for table in ["bw_table", "qs_table"]:
+        print(f"Comparing {table} to {os.path.join(ref_dir, table)}")
+        assert filecmp.cmp(table, os.path.join(ref_dir, table), shallow=False)
+
+    filename_end = sys.argv[1]
+    data_set_end = yt.load(filename_end)
+
+    # no particles can be created on the first timestep so we have 2 timesteps in the test case,
+    # with only the second one resulting in particle creation
+    dt = data_set_end.current_time.to_value() / 2.0
+
+    all_data_end = data_set_end.all_data()
+    particle_data = {}
+    names, types = ac.get_all_species_names_and_types()
+    for spec_name, is_photon in zip(names, types):
+        data = {}
+        data["px"] = all_data_end[spec_name, "particle_momentum_x"].v
+        data["py"] = all_data_end[spec_name, "particle_momentum_y"].v
+        data["pz"] = all_data_end[spec_name, "particle_momentum_z"].v
+        data["w"] = all_data_end[spec_name, "particle_weighting"].v
+        if is_photon:
+            data["opt"] = all_data_end[spec_name, "particle_opticalDepthBW"].v
+        else:
+            data["opt"] = all_data_end[spec_name, "particle_opticalDepthQSR"].v
+        particle_data[spec_name] = data
+
+    ac.check(dt, particle_data)
+
+
+if __name__ == "__main__":
+    main()
@@ -29,22 +29,27 @@ import checksumAPI
 # Command line argument
 fn = sys.argv[1]
 
-# Load costs data
-data = np.genfromtxt("./diags/reducedfiles/LBC.txt")
-data = data[:, 2:]
-
-# Compute the number of datafields saved per box
+# Compute the number of columns before the data of the boxes (step, time, and
+# the quality of the fit of the cost model with the `Model` costs update)
+# and the number of datafields saved per box
 n_data_fields = 0
 with open("./diags/reducedfiles/LBC.txt") as f:
     h = f.readlines()[0]
-    unique_headers = ["".join([ln for ln in w if not ln.isdigit()]) for w in h.split()][
-        2::
+    headers = h.split()
+    n_global_fields = next(i for i, w in enumerate(headers) if "cost_box_" in w)
+    unique_headers = ["".join([ln for ln in w if not ln.isdigit()]) for w in headers][
+        n_global_fields::
     ]
     n_data_fields = len(set(unique_headers))
     f.close()
 
+# Load costs data
+data = np.genfromtxt("./diags/reducedfiles/LBC.txt")
+model_data = data[:, 2:n_global_fields]
+data = data[:, n_global_fields:]
+
 # From data header, data layout is:
-#     [step, time,
+#     [step, time, (cost_model_r2, cost_model_relative_residual, cost_model_num_boxes if Model costs update,)
 #      cost_box_0, proc_box_0, lev_box_0, i_low_box_0, j_low_box_0, k_low_box_0(, gpu_ID_box_0 if GPU run), hostname_box_0,
 #      cost_box_1, proc_box_1, lev_box_1, i_low_box_1, j_low_box_1, k_low_box_1(, gpu_ID_box_1 if GPU run), hostname_box_1,
 #      ...
@@ -54,7 +59,11 @@ with open("./diags/reducedfiles/LBC.txt") as f:
 # Function to get efficiency at an iteration i
 def get_efficiency(i):
     # First get the unique ranks
-    costs, ranks = data[i, 0::n_data_fields], data[i, 1::n_data_fields].astype(int)
+    costs, ranks = data[i, 0::n_data_fields], data[i, 1::n_data_fields]
+    # The number of boxes changes with the regrid for load balance,
+    # in which case the data of the missing boxes is NaN
+    valid = ~np.isnan(costs)
+    costs, ranks = costs[valid], ranks[valid].astype(int)
     rank_to_cost_map = {r: 0.0 for r in set(ranks)}
 
     # Compute efficiency before/after load balance and check it is improved
@@ -77,6 +86,13 @@ print("load balance efficiency (after load balance): ", efficiency_after)
 # than non-load balanced case
 assert efficiency_before < efficiency_after
 
+# With the `Model` costs update, the cost model is fitted at the load balance step
+if model_data.shape[1] > 0:
+    r2, relative_residual, num_boxes = model_data[2]
+    print("cost model: R^2 =", r2, ", relative residual =", relative_residual)
+    assert num_boxes > 0
+    assert r2 <= 1.0 and relative_residual >= 0.0
+
 # The PICMI and native input versions run the same test, so
 # their results are compared to the same benchmark file
 test_name = os.path.split(os.getcwd())[1]
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This script checks that splitting and merging the boxes of level 0 during
+# load balance (algo.load_balance_regrid = 1) does not change the fields:
+# they are compared with those of the same simulation run without regrid,
+# in the directory of the base test, whose name is that of this test without
+# the suffix "_regrid" (this test depends on the base test).
+
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+# relative tolerance: the results only differ by the order of the operations
+tolerance = 1.0e-10
+
+fn = sys.argv[1]
+test_dir = os.getcwd()
+assert test_dir.endswith("_regrid")
+fn_ref = os.path.join(test_dir[: -len("_regrid")], fn)
+
+ds = yt.load(fn)
+ds_ref = yt.load(fn_ref)
+
+# the boxes must have been split
+print(f"number of boxes: {ds.index.num_grids} (without regrid: {ds_ref.index.num_grids})")
+assert ds.index.num_grids > ds_ref.index.num_grids
+
+data = ds.covering_grid(
+    level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+)
+data_ref = ds_ref.covering_grid(
+    level=0, left_edge=ds_ref.domain_left_edge, dims=ds_ref.domain_dimensions
+)
+
+for field in ["Ex", "Ey", "Ez", "Bx", "By", "Bz", "jx", "jy", "jz"]:
+    F = data[("boxlib", field)].to_ndarray()
+    F_ref = data_ref[("boxlib", field)].to_ndarray()
+    error = np.amax(np.abs(F - F_ref)) / np.amax(np.abs(F_ref))
+    print(f"{field}: relative error = {error}")
+    assert error < tolerance
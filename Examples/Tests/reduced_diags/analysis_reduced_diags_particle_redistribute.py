@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script tests the reduced diagnostics `ParticleRedistribute`.
+# The setup is made of two identical species drifting along x through
+# boxes owned by two MPI ranks. The electrons do not communicate their
+# user-defined attribute in the particle redistribution, the positrons do.
+# The test checks that both species move and send the same particles,
+# that particles are sent to the other rank, and that fewer bytes are
+# sent per electron than per positron.
+
+import os
+import sys
+
+import numpy as np
+
+sys.path.insert(1, "../../../../warpx/Regression/Checksum/")
+import checksumAPI
+
+# Command line argument
+fn = sys.argv[1]
+
+# From data header, data layout is:
+#     [step, time,
+#      total_moved, total_sent, total_bytes_sent,
+#      electrons_moved, electrons_sent, electrons_bytes_sent,
+#      positrons_moved, positrons_sent, positrons_bytes_sent]
+data = np.loadtxt("./diags/reducedfiles/PR.txt")
+total = data[:, 2:5]
+electrons = data[:, 5:8]
+positrons = data[:, 8:11]
+
+# The totals are the sums over the species
+assert np.all(total == electrons + positrons)
+
+# The two species move in the same way
+assert np.all(electrons[:, 0:2] == positrons[:, 0:2])
+
+# Particles cross the box boundaries and some of them are sent to the other rank
+assert np.any(electrons[:, 0] > 0)
+assert np.all(electrons[:, 1] <= electrons[:, 0])
+assert np.any(electrons[:, 1] > 0)
+
+# The bytes sent per particle are constant and smaller without the attribute `tag`
+sent = electrons[:, 1] > 0
+electron_bytes = electrons[sent, 2] / electrons[sent, 1]
+positron_bytes = positrons[sent, 2] / positrons[sent, 1]
+print("bytes sent per particle (electrons, positrons):", electron_bytes[0], positron_bytes[0])
+assert np.all(electron_bytes == electron_bytes[0])
+assert np.all(positron_bytes == positron_bytes[0])
+assert positron_bytes[0] - electron_bytes[0] in [4, 8]
+
+# compare checksums
+test_name = os.path.split(os.getcwd())[1]
+checksumAPI.evaluate_checksum(test_name, fn)
@@ -2660,7 +2660,7 @@ class Simulation(picmistandard.PICMI_Simulation):
     warpx_load_balance_knapsack_factor: float, default=1.24
         (See documentation)
 
-    warpx_load_balance_costs_update: {'heuristic' or 'timers'}, optional
+    warpx_load_balance_costs_update: {'heuristic', 'timers' or 'model'}, optional
         (See documentation)
 
     warpx_costs_heuristic_particles_wt: float, optional
@@ -2669,6 +2669,15 @@ class Simulation(picmistandard.PICMI_Simulation):
     warpx_costs_heuristic_cells_wt: float, optional
         (See documentation)
 
+    warpx_costs_model_history: integer, optional
+        (See documentation)
+
+    warpx_costs_model_extrapolate: bool, optional
+        (See documentation)
+
+    warpx_costs_model_min_r2: float, optional
+        (See documentation)
+
     warpx_use_fdtd_nci_corr: bool, optional
         Whether to use the NCI correction when using the FDTD solver
 
@@ -2778,6 +2787,9 @@ class Simulation(picmistandard.PICMI_Simulation):
             "warpx_costs_heuristic_particles_wt", None
         )
         self.costs_heuristic_cells_wt = kw.pop("warpx_costs_heuristic_cells_wt", None)
+        self.costs_model_history = kw.pop("warpx_costs_model_history", None)
+        self.costs_model_extrapolate = kw.pop("warpx_costs_model_extrapolate", None)
+        self.costs_model_min_r2 = kw.pop("warpx_costs_model_min_r2", None)
         self.use_fdtd_nci_corr = kw.pop("warpx_use_fdtd_nci_corr", None)
         self.amr_check_input = kw.pop("warpx_amr_check_input", None)
         self.amr_restart = kw.pop("warpx_amr_restart", None)
@@ -2848,6 +2860,9 @@ class Simulation(picmistandard.PICMI_Simulation):
         pywarpx.algo.load_balance_costs_update = self.load_balance_costs_update
         pywarpx.algo.costs_heuristic_particles_wt = self.costs_heuristic_particles_wt
         pywarpx.algo.costs_heuristic_cells_wt = self.costs_heuristic_cells_wt
+        pywarpx.algo.costs_model_history = self.costs_model_history
+        pywarpx.algo.costs_model_extrapolate = self.costs_model_extrapolate
+        pywarpx.algo.costs_model_min_r2 = self.costs_model_min_r2
 
         pywarpx.warpx.grid_type = self.grid_type
         pywarpx.warpx.do_current_centering = self.do_current_centering
@@ -3067,7 +3082,7 @@ class FieldDiagnostic(picmistandard.PICMI_FieldDiagnostic, WarpXDiagnosticBase):
     warpx_plot_raw_fields_guards: bool, optional
         Flag whether the raw fields should include the guard cells
 
-    warpx_format: {plotfile, checkpoint, openpmd, ascent, sensei}, optional
+    warpx_format: {plotfile, checkpoint, openpmd, ascent, sensei, stream}, optional
         Diagnostic file format
 
     warpx_openpmd_backend: {bp, h5, json}, optional
@@ -3098,6 +3113,10 @@ class FieldDiagnostic(picmistandard.PICMI_FieldDiagnostic, WarpXDiagnosticBase):
         Species for which to calculate particle_fields_to_plot functions. Fields will
         be calculated separately for each specified species. If not passed, default is
         all of the available particle species.
+
+    warpx_roi_track_species: string, optional
+        Species whose centroid the region of interest, given by lower_bound and
+        upper_bound, follows.
     """
 
     def init(self, kw):
@@ -3114,6 +3133,7 @@ class FieldDiagnostic(picmistandard.PICMI_FieldDiagnostic, WarpXDiagnosticBase):
         self.dump_last_timestep = kw.pop("warpx_dump_last_timestep", None)
         self.particle_fields_to_plot = kw.pop("warpx_particle_fields_to_plot", [])
         self.particle_fields_species = kw.pop("warpx_particle_fields_species", None)
+        self.roi_track_species = kw.pop("warpx_roi_track_species", None)
 
     def diagnostic_initialize_inputs(self):
         self.add_diagnostic()
@@ -3125,6 +3145,7 @@ class FieldDiagnostic(picmistandard.PICMI_FieldDiagnostic, WarpXDiagnosticBase):
         self.diagnostic.file_min_digits = self.file_min_digits
         self.diagnostic.dump_rz_modes = self.dump_rz_modes
         self.diagnostic.dump_last_timestep = self.dump_last_timestep
+        self.diagnostic.roi_track_species = self.roi_track_species
         self.diagnostic.intervals = self.period
         self.diagnostic.diag_lo = self.lower_bound
         self.diagnostic.diag_hi = self.upper_bound
@@ -3328,6 +3349,12 @@ class ParticleDiagnostic(picmistandard.PICMI_ParticleDiagnostic, WarpXDiagnostic
         a dictionary is given the keys should be species with the value
         specifying the stride for that species.
 
+    warpx_target_count: integer or dict, optional
+        Number of particles of a uniform random sample to include in the
+        diagnostic. If an integer is given the same count will be used for all
+        species, if a dictionary is given the keys should be species with the
+        value specifying the count for that species.
+
     warpx_dump_last_timestep: bool, optional
         If true, the last timestep is dumped regardless of the diagnostic period/intervals.
 
@@ -3343,6 +3370,7 @@ class ParticleDiagnostic(picmistandard.PICMI_ParticleDiagnostic, WarpXDiagnostic
         self.file_min_digits = kw.pop("warpx_file_min_digits", None)
         self.random_fraction = kw.pop("warpx_random_fraction", None)
         self.uniform_stride = kw.pop("warpx_uniform_stride", None)
+        self.target_count = kw.pop("warpx_target_count", None)
         self.plot_filter_function = kw.pop("warpx_plot_filter_function", None)
         self.dump_last_timestep = kw.pop("warpx_dump_last_timestep", None)
 
@@ -3471,6 +3499,14 @@ class ParticleDiagnostic(picmistandard.PICMI_ParticleDiagnostic, WarpXDiagnostic
             for key, val in self.uniform_stride.items():
                 uniform_stride[key.name] = val
 
+        # check if target count is specified and whether a value is given per species
+        target_count = {}
+        target_count_default = self.target_count
+        if isinstance(self.target_count, dict):
+            target_count_default = None
+            for key, val in self.target_count.items():
+                target_count[key.name] = val
+
         if self.mangle_dict is None:
             # Only do this once so that the same variables are used in this distribution
             # is used multiple times
@@ -3482,6 +3518,7 @@ class ParticleDiagnostic(picmistandard.PICMI_ParticleDiagnostic, WarpXDiagnostic
                 variables=variables,
                 random_fraction=random_fraction.get(name, random_fraction_default),
                 uniform_stride=uniform_stride.get(name, uniform_stride_default),
+                target_count=target_count.get(name, target_count_default),
             )
             expression = pywarpx.my_constants.mangle_expression(
                 self.plot_filter_function, self.mangle_dict
@@ -3528,6 +3565,9 @@ class LabFrameFieldDiagnostic(
     warpx_buffer_size: integer, optional
         Passed to <diagnostic name>.buffer_size
 
+    warpx_streaming_append: bool, optional
+        Passed to <diagnostic name>.streaming_append
+
     warpx_lower_bound: vector of floats, optional
         Passed to <diagnostic name>.lower_bound
 
@@ -3545,6 +3585,7 @@ class LabFrameFieldDiagnostic(
         self.intervals = kw.pop("warpx_intervals", None)
         self.file_min_digits = kw.pop("warpx_file_min_digits", None)
         self.buffer_size = kw.pop("warpx_buffer_size", None)
+        self.streaming_append = kw.pop("warpx_streaming_append", None)
         self.lower_bound = kw.pop("warpx_lower_bound", None)
         self.upper_bound = kw.pop("warpx_upper_bound", None)
 
@@ -3562,6 +3603,7 @@ class LabFrameFieldDiagnostic(
         self.diagnostic.do_back_transformed_fields = True
         self.diagnostic.dt_snapshots_lab = self.dt_snapshots
         self.diagnostic.buffer_size = self.buffer_size
+        self.diagnostic.streaming_append = self.streaming_append
 
         # intervals and num_snapshots_lab cannot both be set
         if self.intervals is not None:
@@ -3644,6 +3686,9 @@ class LabFrameParticleDiagnostic(
 
     warpx_buffer_size: integer, optional
         Passed to <diagnostic name>.buffer_size
+
+    warpx_streaming_append: bool, optional
+        Passed to <diagnostic name>.streaming_append
     """
 
     def init(self, kw):
@@ -3654,6 +3699,7 @@ class LabFrameParticleDiagnostic(
         self.intervals = kw.pop("warpx_intervals", None)
         self.file_min_digits = kw.pop("warpx_file_min_digits", None)
         self.buffer_size = kw.pop("warpx_buffer_size", None)
+        self.streaming_append = kw.pop("warpx_streaming_append", None)
 
     def diagnostic_initialize_inputs(self):
         self.add_diagnostic()
@@ -3667,6 +3713,7 @@ class LabFrameParticleDiagnostic(
         self.diagnostic.do_back_transformed_particles = True
         self.diagnostic.dt_snapshots_lab = self.dt_snapshots
         self.diagnostic.buffer_size = self.buffer_size
+        self.diagnostic.streaming_append = self.streaming_append
 
         # intervals and num_snapshots_lab cannot both be set
         if self.intervals is not None:
@@ -167,3 +167,40 @@ def check_random_filter(fn, filtered_fn, random_fraction, dim, species_name):
         "np.isin(ids + 0.1*cpus," "ids_filtered_warpx + 0.1*cpus_filtered_warpx)"
     )
     check_particle_filter(fn, filtered_fn, random_filter_expression, dim, species_name)
+
+
+## This function is specifically used to test the target count filter. First, we check that the
+## number of dumped particles does not exceed the target and is close to it. Next, we check that
+## the dumped particles are a subset of the unfiltered ones with the generic check_particle_filter
+## function.
+def check_target_count_filter(fn, filtered_fn, target_count, dim, species_name):
+    ds = yt.load(fn)
+    ds_filtered = yt.load(filtered_fn)
+    ad = ds.all_data()
+    ad_filtered = ds_filtered.all_data()
+
+    ## Check that the number of particles is as expected
+    numparts = ad[species_name, "particle_id"].to_ndarray().shape[0]
+    numparts_filtered = ad_filtered["particle_id"].to_ndarray().shape[0]
+    expected_numparts_filtered = min(target_count, numparts)
+    print(
+        "Target count filter: expected and actual number of dumped particles: "
+        + str(expected_numparts_filtered)
+        + " "
+        + str(numparts_filtered)
+    )
+    # The selection oversamples by 3 sigma before trimming to the target, so that it can only
+    # undershoot with a small probability
+    assert numparts_filtered <= expected_numparts_filtered
+    assert numparts_filtered > expected_numparts_filtered - 5 * np.sqrt(
+        expected_numparts_filtered
+    )
+
+    ## Dirty trick to find particles with the same ID + same CPU (does not work with more than 10
+    ## MPI ranks)
+    target_count_filter_expression = (
+        "np.isin(ids + 0.1*cpus," "ids_filtered_warpx + 0.1*cpus_filtered_warpx)"
+    )
+    check_particle_filter(
+        fn, filtered_fn, target_count_filter_expression, dim, species_name
+    )
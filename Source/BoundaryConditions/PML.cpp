@@ -773,8 +773,10 @@ PML::PML (const int lev, const BoxArray& grid_ba,
         // Flags passed to the spectral solver constructor
         const bool in_pml = true;
         const bool periodic_single_box = false;
+        const bool distributed_fft = false;
         const bool update_with_rho = false;
         const bool fft_do_time_averaging = false;
+        const bool on_the_fly_coefficients = false;
         const RealVect dx{AMREX_D_DECL(geom->CellSize(0), geom->CellSize(1), geom->CellSize(2))};
         // Get the cell-centered box, with guard cells
         BoxArray realspace_ba = ba; // Copy box
@@ -783,8 +785,9 @@ PML::PML (const int lev, const BoxArray& grid_ba,
         realspace_ba.enclosedCells().grow(nge); // cell-centered + guard cells
         spectral_solver_fp = std::make_unique<SpectralSolver>(lev, realspace_ba, dm,
             nox_fft, noy_fft, noz_fft, grid_type, v_galilean,
-            v_comoving_zero, dx, dt, in_pml, periodic_single_box, update_with_rho,
-            fft_do_time_averaging, psatd_solution_type, J_in_time, rho_in_time, m_dive_cleaning, m_divb_cleaning);
+            v_comoving_zero, dx, dt, in_pml, periodic_single_box, distributed_fft, update_with_rho,
+            fft_do_time_averaging, psatd_solution_type, J_in_time, rho_in_time, m_dive_cleaning, m_divb_cleaning,
+            on_the_fly_coefficients);
 #endif
     }
 
@@ -885,8 +888,10 @@ PML::PML (const int lev, const BoxArray& grid_ba,
             // Flags passed to the spectral solver constructor
             const bool in_pml = true;
             const bool periodic_single_box = false;
+            const bool distributed_fft = false;
             const bool update_with_rho = false;
             const bool fft_do_time_averaging = false;
+            const bool on_the_fly_coefficients = false;
             const RealVect cdx{AMREX_D_DECL(cgeom->CellSize(0), cgeom->CellSize(1), cgeom->CellSize(2))};
             // Get the cell-centered box, with guard cells
             BoxArray realspace_cba = cba; // Copy box
@@ -895,8 +900,9 @@ PML::PML (const int lev, const BoxArray& grid_ba,
             realspace_cba.enclosedCells().grow(nge); // cell-centered + guard cells
             spectral_solver_cp = std::make_unique<SpectralSolver>(lev, realspace_cba, cdm,
                 nox_fft, noy_fft, noz_fft, grid_type, v_galilean,
-                v_comoving_zero, cdx, dt, in_pml, periodic_single_box, update_with_rho,
-                fft_do_time_averaging, psatd_solution_type, J_in_time, rho_in_time, m_dive_cleaning, m_divb_cleaning);
+                v_comoving_zero, cdx, dt, in_pml, periodic_single_box, distributed_fft, update_with_rho,
+                fft_do_time_averaging, psatd_solution_type, J_in_time, rho_in_time, m_dive_cleaning, m_divb_cleaning,
+                on_the_fly_coefficients);
 #endif
         }
     }
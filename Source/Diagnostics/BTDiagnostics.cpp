@@ -44,6 +44,7 @@
 #include <cstdio>
 #include <memory>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 using namespace amrex::literals;
@@ -52,6 +53,28 @@ using namespace warpx::fields;
 namespace
 {
     constexpr int permission_flag_rwxrxrx = 0755;
+
+    /** Chop a buffer box in boxes of at most max_size cells, and then keep halving the
+     *  largest direction of the boxes (except skip_dir) until there are at least nboxes
+     *  boxes, or no direction can be halved anymore */
+    amrex::BoxArray ChopBufferBox (const amrex::Box& box, amrex::IntVect max_size,
+                                   const int nboxes, const int skip_dir)
+    {
+        max_size.min(box.length());
+        amrex::BoxArray ba(box);
+        ba.maxSize(max_size);
+        while (static_cast<int>(ba.size()) < nboxes) {
+            int idir = -1;
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                if (idim != skip_dir && max_size[idim] > 1 &&
+                    (idir < 0 || max_size[idim] > max_size[idir])) { idir = idim; }
+            }
+            if (idir < 0) { break; }
+            max_size[idir] = (max_size[idir] + 1) / 2;
+            ba.maxSize(max_size);
+        }
+        return ba;
+    }
 }
 
 BTDiagnostics::BTDiagnostics (int i, const std::string& name)
@@ -262,6 +285,10 @@ BTDiagnostics::ReadParameters ()
         "For back-transformed diagnostics, user should specify either dz_snapshots_lab or dt_snapshots_lab");
 
     utils::parser::queryWithParser(pp_diag_name, "buffer_size", m_buffer_size);
+    pp_diag_name.query("streaming_append", m_streaming_append);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !m_streaming_append || m_format == "openpmd",
+        "<diag>.streaming_append is only supported with <diag>.format = openpmd");
 #ifdef WARPX_DIM_RZ
     const amrex::Vector< std::string > BTD_varnames_supported = {"Er", "Et", "Ez",
                                                            "Br", "Bt", "Bz",
@@ -903,7 +930,15 @@ BTDiagnostics::DefineFieldBufferMultiFab (const int i_buffer, const int lev)
     const int hi_k_lab = m_buffer_k_index_hi[i_buffer];
     m_buffer_box[i_buffer].setSmall( m_moving_window_dir, hi_k_lab - m_buffer_size + 1);
     m_buffer_box[i_buffer].setBig( m_moving_window_dir, hi_k_lab );
-    const amrex::BoxArray buffer_ba( m_buffer_box[i_buffer] );
+    amrex::BoxArray buffer_ba( m_buffer_box[i_buffer] );
+    if (m_streaming_append) {
+        // Distribute the buffer over all MPI ranks by chopping it in the transverse
+        // directions only, so that every box contains complete z-columns of the buffer
+        amrex::IntVect max_box_size = warpx.maxGridSize(lev);
+        max_box_size[m_moving_window_dir] = m_buffer_box[i_buffer].length(m_moving_window_dir);
+        buffer_ba = ChopBufferBox(m_buffer_box[i_buffer], max_box_size,
+                                  amrex::ParallelDescriptor::NProcs(), m_moving_window_dir);
+    }
     // Generate a new distribution map for the back-transformed buffer multifab
     const amrex::DistributionMapping buffer_dmap(buffer_ba);
     // Number of guard cells for the output buffer is zero.
@@ -920,11 +955,11 @@ BTDiagnostics::DefineFieldBufferMultiFab (const int i_buffer, const int lev)
             warpx.Geom(lev).CellSize(idim):
             dz_lab(warpx.getdt(lev), ref_ratio[m_moving_window_dir]);
         const amrex::Real buffer_lo = m_snapshot_domain_lab[i_buffer].lo(idim)
-                                + ( buffer_ba.getCellCenteredBox(0).smallEnd(idim)
+                                + ( m_buffer_box[i_buffer].smallEnd(idim)
                                   - m_snapshot_box[i_buffer].smallEnd(idim)
                                   ) * cellsize;
         const amrex::Real buffer_hi = m_snapshot_domain_lab[i_buffer].lo(idim)
-                                + ( buffer_ba.getCellCenteredBox( static_cast<int>(buffer_ba.size()-1) ).bigEnd(idim)
+                                + ( m_buffer_box[i_buffer].bigEnd(idim)
                                   - m_snapshot_box[i_buffer].smallEnd(idim)
                                   + 1 ) * cellsize;
         m_buffer_domain_lab[i_buffer].setLo(idim, buffer_lo);
@@ -949,7 +984,8 @@ BTDiagnostics::DefineFieldBufferMultiFab (const int i_buffer, const int lev)
                                                       WarpX::RefRatio(lev-1) );
     }
     m_field_buffer_multifab_defined[i_buffer] = 1;
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE( m_mf_output[i_buffer][lev].boxArray().size() == 1,
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE( m_streaming_append ||
+        m_mf_output[i_buffer][lev].boxArray().size() == 1,
         "BoxArray size must be 1 for back-transformed diagnostics multifab that stores buffers");
 }
 
@@ -1032,6 +1068,10 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
                 vrefratio.push_back(m_particles_buffer[i_buffer][0]->GetParGDB()->refRatio(lev));
             }
         }
+    }
+    // When streaming, the particles stay in the tiles of the rank that
+    // back-transformed them and are written from there directly.
+    if (!m_particles_buffer.at(i_buffer).empty() && !m_streaming_append) {
         // Redistribute particles in the lab frame box arrays that correspond to the buffer
         // Prior to redistribute, increase buffer box and Box in ParticleBoxArray by 1 index in the
         // lo and hi-end, so particles can be binned in the boxes correctly.
@@ -1048,12 +1088,12 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
             // BTD output is single level. Setting particle geometry, dmap, boxarray to level0
             m_particles_buffer[i_buffer][isp]->SetParGDB(vgeom[0], vdmap[0], buffer_ba);
         }
+        RedistributeParticleBuffer(i_buffer);
     }
-    RedistributeParticleBuffer(i_buffer);
 
     // Reset buffer box and particle box array
     if (m_format == "openpmd") {
-        if (!m_particles_buffer.at(i_buffer).empty()) {
+        if (!m_particles_buffer.at(i_buffer).empty() && !m_streaming_append) {
             m_buffer_box[i_buffer].setSmall(m_moving_window_dir, (m_buffer_box[i_buffer].smallEnd(m_moving_window_dir) + 1) );
             m_buffer_box[i_buffer].setBig(m_moving_window_dir, (m_buffer_box[i_buffer].bigEnd(m_moving_window_dir) - 1) );
             m_particles_buffer[i_buffer][0]->SetParticleBoxArray(0,vba.back());
@@ -1065,6 +1105,8 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
             }
         }
     }
+    m_field_compression.Apply(m_mf_output.at(i_buffer), nlev_output);
+
     m_flush_format->WriteToFile(
         m_varnames, m_mf_output.at(i_buffer), m_geom_output.at(i_buffer), warpx.getistep(),
         labtime,
@@ -1072,6 +1114,7 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
         m_plot_raw_fields, m_plot_raw_fields_guards,
         use_pinned_pc, isBTD, i_buffer, m_buffer_flush_counter.at(i_buffer),
         m_max_buffer_multifabs.at(i_buffer), m_geom_snapshot.at(i_buffer).at(0), isLastBTDFlush);
+    m_field_compression.RecordOutput(m_flush_format->FieldBytesWritten());
 
     // Rescaling the box for plotfile after WriteToFile. This is because, for plotfiles, when writing particles, amrex checks if the particles are within the bounds defined by the box. However, in BTD, particles can be (at max) 1 cell outside the bounds of the geometry. So we keep a one-cell bigger box for plotfile when writing out the particle data and rescale after.
     if (m_format == "plotfile") {
@@ -1423,7 +1466,9 @@ BTDiagnostics::InitializeParticleFunctors ()
     {
         // species id corresponding to ith diag species
         const int idx = mpc.getSpeciesID(m_output_species_names[i]);
-        m_all_particle_functors[i] = std::make_unique<BackTransformParticleFunctor>(mpc.GetParticleContainerPtr(idx), m_output_species_names[i], m_num_buffers);
+        m_all_particle_functors[i] = std::make_unique<BackTransformParticleFunctor>(
+            mpc.GetParticleContainerPtr(idx), m_output_species_names[i], m_num_buffers,
+            m_streaming_append);
     }
 
 }
@@ -1469,13 +1514,35 @@ BTDiagnostics::PrepareParticleDataForOutput()
                             DefineFieldBufferMultiFab(i_buffer, lev);
                         }
                         const amrex::Box particle_buffer_box = m_buffer_box[i_buffer];
-                        const amrex::BoxArray buffer_ba( particle_buffer_box );
-                        const amrex::DistributionMapping buffer_dmap(buffer_ba);
-                        m_particles_buffer[i_buffer][i]->SetParticleBoxArray(lev, buffer_ba);
-                        m_particles_buffer[i_buffer][i]->SetParticleDistributionMap(lev, buffer_dmap);
-                        m_particles_buffer[i_buffer][i]->SetParticleGeometry(lev, m_geom_snapshot[i_buffer][lev]);
-                        WARPX_ALWAYS_ASSERT_WITH_MESSAGE( m_particles_buffer[i_buffer][i]->ParticleBoxArray(lev).size() == 1,
-                            "ParticleBoxArray size must be 1 for back-transformed diagnostic particle buffer");
+                        if (m_streaming_append) {
+                            // The buffer box is chopped in at least one box per MPI rank, and
+                            // box i is owned by rank i % nprocs. The back-transformed particles
+                            // are stored in the box whose index is the local rank, in one tile
+                            // per source tile, and are written from there without Redistribute
+                            // (they are therefore not binned in the boxes by position).
+                            const int nprocs = amrex::ParallelDescriptor::NProcs();
+                            const amrex::BoxArray buffer_ba = ChopBufferBox(
+                                particle_buffer_box, particle_buffer_box.length(), nprocs, -1);
+                            WARPX_ALWAYS_ASSERT_WITH_MESSAGE( static_cast<int>(buffer_ba.size()) >= nprocs,
+                                "The buffer of back-transformed diagnostics is too small for <diag>.streaming_append: "
+                                "it must have at least one cell per MPI rank");
+                            amrex::Vector<int> buffer_pmap(buffer_ba.size());
+                            for (int ibox = 0; ibox < buffer_pmap.size(); ++ibox) {
+                                buffer_pmap[ibox] = ibox % nprocs;
+                            }
+                            const amrex::DistributionMapping buffer_dmap( std::move(buffer_pmap) );
+                            m_particles_buffer[i_buffer][i]->SetParticleBoxArray(lev, buffer_ba);
+                            m_particles_buffer[i_buffer][i]->SetParticleDistributionMap(lev, buffer_dmap);
+                            m_particles_buffer[i_buffer][i]->SetParticleGeometry(lev, m_geom_snapshot[i_buffer][lev]);
+                        } else {
+                            const amrex::BoxArray buffer_ba( particle_buffer_box );
+                            const amrex::DistributionMapping buffer_dmap(buffer_ba);
+                            m_particles_buffer[i_buffer][i]->SetParticleBoxArray(lev, buffer_ba);
+                            m_particles_buffer[i_buffer][i]->SetParticleDistributionMap(lev, buffer_dmap);
+                            m_particles_buffer[i_buffer][i]->SetParticleGeometry(lev, m_geom_snapshot[i_buffer][lev]);
+                            WARPX_ALWAYS_ASSERT_WITH_MESSAGE( m_particles_buffer[i_buffer][i]->ParticleBoxArray(lev).size() == 1,
+                                "ParticleBoxArray size must be 1 for back-transformed diagnostic particle buffer");
+                        }
                     }
                 }
                 m_all_particle_functors[i]->PrepareFunctorData (
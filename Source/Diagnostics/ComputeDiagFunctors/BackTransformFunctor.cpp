@@ -14,6 +14,7 @@
 
 #include <AMReX_Array4.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_Extension.H>
 #include <AMReX_FArrayBox.H>
@@ -29,6 +30,7 @@
 #include <cmath>
 #include <map>
 #include <memory>
+#include <utility>
 
 using namespace amrex;
 
@@ -83,13 +85,19 @@ BackTransformFunctor::operator ()(amrex::MultiFab& mf_dst, int /*dcomp*/, const
         // index corresponding to z_boost location in the boost-frame
         const int i_boost = static_cast<int> ( ( m_current_z_boost[i_buffer]
                                             - geom.ProbLo(moving_window_dir) ) / dx );
-        // z-Slice at i_boost with x,y indices same as buffer_box
-        amrex::Box slice_box = m_buffer_box[i_buffer];
-        slice_box.setSmall(moving_window_dir, i_boost);
-        slice_box.setBig(moving_window_dir, i_boost);
+        // z-Slice at i_boost with x,y indices same as each box of the buffer.
+        // The buffer is usually a single box, but it is chopped in the transverse
+        // directions when the full snapshot is accumulated in memory.
+        amrex::BoxList slice_bl;
+        for (int ibox = 0; ibox < mf_dst.boxArray().size(); ++ibox) {
+            amrex::Box slice_box = mf_dst.boxArray()[ibox];
+            slice_box.setSmall(moving_window_dir, i_boost);
+            slice_box.setBig(moving_window_dir, i_boost);
+            slice_bl.push_back(slice_box);
+        }
 
         // Make it a BoxArray
-        const amrex::BoxArray slice_ba(slice_box);
+        const amrex::BoxArray slice_ba(std::move(slice_bl));
         // Define MultiFab with the distribution map of the destination multifab and
         // containing all ten components that were in the slice generated from m_mf_src.
         std::unique_ptr< amrex::MultiFab > tmp_slice_ptr = nullptr;
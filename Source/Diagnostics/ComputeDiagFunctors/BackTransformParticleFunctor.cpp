@@ -12,9 +12,13 @@
 #include "WarpX.H"
 
 #include <AMReX.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_Print.H>
 #include <AMReX_BaseFwd.H>
 
+#include <map>
+#include <utility>
+
 SelectParticles::SelectParticles (const WarpXParIter& a_pti, TmpParticles& tmp_particle_data,
                                   amrex::Real current_z_boost, amrex::Real old_z_boost,
                                   int a_offset)
@@ -70,8 +74,10 @@ LorentzTransformParticles::LorentzTransformParticles ( const WarpXParIter& a_pti
 BackTransformParticleFunctor::BackTransformParticleFunctor (
                               WarpXParticleContainer *pc_src,
                               std::string species_name,
-                              int num_buffers)
-    : m_pc_src{pc_src}, m_species_name{std::move(species_name)}, m_num_buffers{num_buffers}
+                              int num_buffers,
+                              bool rank_local_buffer)
+    : m_pc_src{pc_src}, m_species_name{std::move(species_name)}, m_num_buffers{num_buffers},
+      m_rank_local_buffer{rank_local_buffer}
 {
     InitData();
 }
@@ -89,8 +95,19 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
         const amrex::Real t_boost = warpx.gett_new(0);
         const amrex::Real dt = warpx.getdt(0);
 
+        // With a rank-local buffer, the destination tiles are in the box whose index is the
+        // rank itself (see BTDiagnostics::PrepareParticleDataForOutput), with one tile per
+        // source tile of the rank, so that the source tiles can be processed concurrently
+        const int local_grid = amrex::ParallelDescriptor::MyProc();
+        std::map<std::pair<int, int>, int> local_tile_index;
         for (WarpXParIter pti(*m_pc_src, lev); pti.isValid(); ++pti) {
-            pc_dst.DefineAndReturnParticleTile(lev, pti.index(), pti.LocalTileIndex() );
+            if (m_rank_local_buffer) {
+                const int itile = static_cast<int>(local_tile_index.size());
+                local_tile_index[std::make_pair(pti.index(), pti.LocalTileIndex())] = itile;
+                pc_dst.DefineAndReturnParticleTile(lev, local_grid, itile);
+            } else {
+                pc_dst.DefineAndReturnParticleTile(lev, pti.index(), pti.LocalTileIndex() );
+            }
         }
 
         auto& particles = m_pc_src->GetParticles(lev);
@@ -134,7 +151,9 @@ BackTransformParticleFunctor::operator () (PinnedMemoryParticleContainer& pc_dst
                 });
 
                 const int total_partdiag_size = amrex::Scan::ExclusiveSum(np,Flag,IndexLocation);
-                auto& ptile_dst = pc_dst.DefineAndReturnParticleTile(lev, pti.index(), pti.LocalTileIndex() );
+                auto& ptile_dst = m_rank_local_buffer ?
+                    pc_dst.DefineAndReturnParticleTile(lev, local_grid, local_tile_index.at(index)) :
+                    pc_dst.DefineAndReturnParticleTile(lev, pti.index(), pti.LocalTileIndex() );
                 auto old_size = ptile_dst.numParticles();
                 ptile_dst.resize(old_size + total_partdiag_size);
                 amrex::filterParticles(ptile_dst, ptile_src, GetParticleFilter, 0, old_size, np);
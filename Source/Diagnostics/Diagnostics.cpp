@@ -12,6 +12,7 @@
 #endif
 #include "FlushFormats/FlushFormatPlotfile.H"
 #include "FlushFormats/FlushFormatSensei.H"
+#include "FlushFormats/FlushFormatStream.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/Algorithms/IsIn.H"
 #include "Utils/Parser/ParserUtils.H"
@@ -57,6 +58,7 @@ Diagnostics::BaseReadParameters ()
         pp_diag_name, "file_min_digits", m_file_min_digits);
     pp_diag_name.query("format", m_format);
     pp_diag_name.query("dump_last_timestep", m_dump_last_timestep);
+    m_field_compression = FieldCompression(m_diag_name);
 
     const amrex::ParmParse pp_geometry("geometry");
     std::string dims;
@@ -500,7 +502,7 @@ Diagnostics::InitBaseData ()
     }
     // Construct Flush class.
     if        (m_format == "plotfile"){
-        m_flush_format = std::make_unique<FlushFormatPlotfile>() ;
+        m_flush_format = std::make_unique<FlushFormatPlotfile>(m_diag_name) ;
     } else if (m_format == "checkpoint"){
         // creating checkpoint format
         m_flush_format = std::make_unique<FlushFormatCheckpoint>() ;
@@ -517,6 +519,8 @@ Diagnostics::InitBaseData ()
         WARPX_ABORT_WITH_MESSAGE(
             "To use SENSEI in situ, compile with USE_SENSEI=TRUE");
 #endif
+    } else if (m_format == "stream") {
+        m_flush_format = std::make_unique<FlushFormatStream>(m_diag_name);
     } else if (m_format == "openpmd"){
 #ifdef WARPX_USE_OPENPMD
         m_flush_format = std::make_unique<FlushFormatOpenPMD>(m_diag_name);
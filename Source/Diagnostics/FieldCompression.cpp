@@ -0,0 +1,181 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FieldCompression.H"
+
+#include "Diagnostics/OpenPMDHelpFunction.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX_Array4.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#include <sstream>
+
+using namespace amrex::literals;
+
+FieldCompression::FieldCompression (const std::string& diag_name)
+    : m_diag_name{diag_name}
+{
+    const amrex::ParmParse pp_diag_name(diag_name);
+
+    std::string precision = "double";
+    pp_diag_name.query("compression.precision", precision);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        precision == "double" || precision == "single",
+        diag_name + ".compression.precision must be double or single");
+    m_single_precision = (precision == "single");
+
+    utils::parser::queryWithParser(pp_diag_name, "compression.abs_error", m_abs_error);
+
+    // per-field error bounds: <diag>.compression.<field>.abs_error
+    std::string const prefix = diag_name + ".compression";
+    std::string const suffix = ".abs_error";
+    for (auto const& key : amrex::ParmParse::getEntries(prefix)) {
+        // strip "<diag>.compression." from the key
+        std::string const name = key.substr(prefix.size() + 1);
+        if (name.size() <= suffix.size() ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            continue;
+        }
+        std::string const varname = name.substr(0, name.size() - suffix.size());
+        amrex::Real abs_error = 0._rt;
+        utils::parser::getWithParser(pp_diag_name, ("compression." + name).c_str(), abs_error);
+        m_field_abs_error[varname] = abs_error;
+    }
+
+    for (auto const& [varname, abs_error] : m_field_abs_error) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(abs_error >= 0._rt,
+            diag_name + ".compression." + varname + ".abs_error must be non-negative");
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_abs_error >= 0._rt,
+        diag_name + ".compression.abs_error must be non-negative");
+
+    std::string format = "plotfile";
+    pp_diag_name.query("format", format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !IsActive() || format == "plotfile" || format == "openpmd",
+        diag_name + ".compression is only supported with the plotfile and openpmd formats");
+
+    // The error bounds are only enforced by an error-bounded ADIOS2 operator of the
+    // openPMD writer (e.g. sz or zfp): without a codec, bounding the error would
+    // degrade the data without writing fewer bytes.
+    bool has_abs_error = m_abs_error > 0._rt;
+    for (auto const& [varname, abs_error] : m_field_abs_error) {
+        if (abs_error > 0._rt) { has_abs_error = true; }
+    }
+    if (has_abs_error) {
+        std::string operator_type;
+        pp_diag_name.query("adios2_operator.type", operator_type);
+        std::string openpmd_backend = "default";
+        pp_diag_name.query("openpmd_backend", openpmd_backend);
+        if (openpmd_backend == "default") { openpmd_backend = WarpXOpenPMDFileType(); }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            format == "openpmd" && openpmd_backend == "bp" && !operator_type.empty(),
+            diag_name + ".compression.abs_error requires " + diag_name + ".format = openpmd"
+            + " with the ADIOS2 backend (" + diag_name + ".openpmd_backend = bp)"
+            + " and an error-bounded operator (" + diag_name + ".adios2_operator.type, e.g. sz or zfp)");
+    }
+}
+
+amrex::Real
+FieldCompression::AbsError (const std::string& varname) const
+{
+    auto const it = m_field_abs_error.find(varname);
+    return (it != m_field_abs_error.end()) ? it->second : m_abs_error;
+}
+
+void
+FieldCompression::Apply (amrex::Vector<amrex::MultiFab>& mf, int nlev)
+{
+    if (!IsActive()) { return; }
+
+    WARPX_PROFILE("FieldCompression::Apply()");
+
+    auto const wt = amrex::second();
+
+    bool const single_precision = m_single_precision;
+
+    m_bytes_in = 0;
+    for (int lev = 0; lev < nlev; ++lev) {
+        m_bytes_in += mf[lev].boxArray().numPts() * mf[lev].nComp()
+            * static_cast<amrex::Long>(sizeof(amrex::Real));
+        // the error bounds are enforced by the ADIOS2 operator, at the flush
+        if (!single_precision) { continue; }
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+        for (amrex::MFIter mfi(mf[lev], amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            const amrex::Box& bx = mfi.growntilebox();
+            amrex::Array4<amrex::Real> const& arr = mf[lev].array(mfi);
+            amrex::ParallelFor(bx, mf[lev].nComp(),
+                [=] AMREX_GPU_DEVICE (int i, int j, int k, int n)
+                {
+                    arr(i,j,k,n) = static_cast<amrex::Real>(static_cast<float>(arr(i,j,k,n)));
+                });
+        }
+    }
+
+    amrex::Gpu::streamSynchronize();
+    m_codec_time = amrex::second() - wt;
+    amrex::ParallelDescriptor::ReduceRealMax(m_codec_time);
+}
+
+void
+FieldCompression::RecordOutput (amrex::Long bytes_written)
+{
+    if (!IsActive()) { return; }
+
+    ++m_noutputs;
+    m_total_codec_time += m_codec_time;
+    if (bytes_written >= 0) {
+        m_total_bytes_in += m_bytes_in;
+        m_total_bytes_written += bytes_written;
+    }
+
+    if (WarpX::GetInstance().Verbose()) {
+        std::stringstream ss;
+        ss << m_diag_name << ": fields compressed in " << m_codec_time << " s";
+        if (bytes_written >= 0) {
+            ss << ", " << bytes_written << " bytes written for " << m_bytes_in
+               << " bytes in memory (ratio " << Ratio(m_bytes_in, bytes_written) << ")";
+        }
+        amrex::Print() << Utils::TextMsg::Info(ss.str());
+    }
+}
+
+void
+FieldCompression::PrintReport () const
+{
+    if (!IsActive() || m_noutputs == 0) { return; }
+
+    std::stringstream ss;
+    ss << m_diag_name << ": field compression of " << m_noutputs
+       << " outputs in " << m_total_codec_time << " s";
+    if (m_total_bytes_written > 0) {
+        ss << ", " << m_total_bytes_written << " bytes written for "
+           << m_total_bytes_in << " bytes in memory (ratio "
+           << Ratio(m_total_bytes_in, m_total_bytes_written) << ")";
+    }
+    amrex::Print() << ss.str() << "\n";
+}
+
+double
+FieldCompression::Ratio (amrex::Long bytes_in, amrex::Long bytes_written)
+{
+    return (bytes_written > 0) ?
+        static_cast<double>(bytes_in) / static_cast<double>(bytes_written) : 1.;
+}
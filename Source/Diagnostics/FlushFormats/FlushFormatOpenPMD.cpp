@@ -2,6 +2,7 @@
 
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
+#include "Diagnostics/FieldCompression.H"
 #include "Diagnostics/OpenPMDHelpFunction.H"
 #include "WarpX.H"
 
@@ -110,7 +111,8 @@ FlushFormatOpenPMD::FlushFormatOpenPMD (const std::string& diag_name)
         operator_type, operator_parameters,
         engine_type, engine_parameters,
         warpx.getPMLdirections(),
-        warpx.GetAuthors()
+        warpx.GetAuthors(),
+        FieldCompression(diag_name)
     );
 }
 
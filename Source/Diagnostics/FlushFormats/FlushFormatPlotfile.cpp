@@ -1,9 +1,9 @@
 #include "FlushFormatPlotfile.H"
 
 #include "FieldSolver/Fields.H"
+#include "Diagnostics/FieldCompression.H"
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
-#include "Particles/Filter/FilterFunctors.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Particles/ParticleIO.H"
 #include "Particles/PinnedMemoryParticleContainer.H"
@@ -17,6 +17,7 @@
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
+#include <AMReX_FArrayBox.H>
 #include <AMReX_GpuAllocators.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IntVect.H>
@@ -41,6 +42,7 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <map>
 #include <memory>
@@ -53,6 +55,39 @@ using namespace warpx::fields;
 namespace
 {
     const std::string default_level_prefix {"Level_"};
+
+    /** Total size of the field data files (Level_<lev>/Cell_D_*) of a plotfile
+     *
+     * \param[in] plotfile_name name of the plotfile directory
+     * \param[in] nlev number of levels in the plotfile
+     */
+    amrex::Long FieldBytesOnDisk (const std::string& plotfile_name, int nlev)
+    {
+        // wait for all the ranks to have written their data
+        amrex::ParallelDescriptor::Barrier();
+        amrex::Long nbytes = 0;
+        if (amrex::ParallelDescriptor::IOProcessor()) {
+            for (int lev = 0; lev < nlev; ++lev) {
+                const std::filesystem::path level_dir =
+                    plotfile_name + "/" + default_level_prefix + std::to_string(lev);
+                for (auto const& entry : std::filesystem::directory_iterator(level_dir)) {
+                    if (entry.is_regular_file() &&
+                        entry.path().filename().string().rfind("Cell_D_", 0) == 0) {
+                        nbytes += static_cast<amrex::Long>(entry.file_size());
+                    }
+                }
+            }
+        }
+        amrex::ParallelDescriptor::Bcast(&nbytes, 1, amrex::ParallelDescriptor::IOProcessorNumber());
+        return nbytes;
+    }
+}
+
+FlushFormatPlotfile::FlushFormatPlotfile (const std::string& diag_name)
+{
+    const FieldCompression field_compression(diag_name);
+    m_single_precision_fields = field_compression.SinglePrecision();
+    m_measure_field_bytes = field_compression.IsActive();
 }
 
 void
@@ -89,6 +124,9 @@ FlushFormatPlotfile::WriteToFile (
     const VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(amrex::VisMF::Header::Version_v1);
     if (plot_raw_fields) { rfs.emplace_back("raw_fields"); }
+    // the FAB format selects the precision in which the field data is written
+    const FABio::Format current_fab_format = FArrayBox::getFormat();
+    if (m_single_precision_fields) { FArrayBox::setFormat(FABio::FAB_NATIVE_32); }
     amrex::WriteMultiLevelPlotfile(filename, nlev,
                                    amrex::GetVecOfConstPtrs(mf),
                                    varnames, geom,
@@ -98,6 +136,8 @@ FlushFormatPlotfile::WriteToFile (
                                    "Cell",
                                    rfs
                                    );
+    FArrayBox::setFormat(current_fab_format);
+    if (m_measure_field_bytes) { m_field_bytes_written = FieldBytesOnDisk(filename, nlev); }
 
     WriteAllRawFields(plot_raw_fields, nlev, filename, plot_raw_fields_guards);
 
@@ -391,33 +431,10 @@ FlushFormatPlotfile::WriteParticles(const std::string& dir,
         // plot by default
         int_flags.resize(tmp.NumIntComps(), 1);
 
-        const auto mass = pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
-        RandomFilter const random_filter(part_diag.m_do_random_filter,
-                                         part_diag.m_random_fraction);
-        UniformFilter const uniform_filter(part_diag.m_do_uniform_filter,
-                                           part_diag.m_uniform_stride);
-        ParserFilter parser_filter(part_diag.m_do_parser_filter,
-                                   utils::parser::compileParser<ParticleDiag::m_nvars>
-                                       (part_diag.m_particle_filter_parser.get()),
-                                   pc->getMass(), time);
-        parser_filter.m_units = InputUnits::SI;
-        GeometryFilter const geometry_filter(part_diag.m_do_geom_filter,
-                                             part_diag.m_diag_domain);
-
         if (!isBTD) {
-            particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
-            using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-            tmp.copyParticles(*pc,
-                              [random_filter,uniform_filter,parser_filter,geometry_filter]
-                              AMREX_GPU_HOST_DEVICE
-                              (const SrcData& src, int ip, const amrex::RandomEngine& engine)
-            {
-                const SuperParticleType& p = src.getSuperParticle(ip);
-                return random_filter(p, engine) * uniform_filter(p, engine)
-                    * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
-            particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
+            part_diag.SelectParticles(tmp, *pc, time);
         } else {
+            const auto mass = pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
             tmp.copyParticles(*pinned_pc, true);
             particlesConvertUnits(ConvertDirection::WarpX_to_SI, &tmp, mass);
         }
@@ -0,0 +1,457 @@
+#include "FlushFormatStream.H"
+
+#include "Diagnostics/ParticleDiag/ParticleDiag.H"
+#include "Particles/PinnedMemoryParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+#include "WarpX.H"
+
+#include <AMReX.H>
+#include <AMReX_Box.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuAllocators.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#ifndef _WIN32
+#   include <cerrno>
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/socket.h>
+#   include <sys/stat.h>
+#   include <sys/un.h>
+#   include <unistd.h>
+#endif
+
+using namespace amrex;
+
+namespace
+{
+    constexpr std::uint32_t stream_version = 1;
+
+    /** Header of the shared-memory ring buffer, see FlushFormatStream.H */
+    struct RingHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t ring_size;
+        std::uint64_t slot_size;
+        std::atomic<std::uint64_t> head;
+        std::atomic<std::uint64_t> tail;
+        std::atomic<std::uint32_t> closed;
+    };
+    constexpr std::size_t ring_header_size = 64;
+    static_assert(sizeof(RingHeader) <= ring_header_size,
+                  "The ring buffer header must fit in 64 bytes");
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "The ring buffer counters must be lock-free to be shared between processes");
+
+    template <typename T>
+    void Append (std::vector<char>& buf, const T& value)
+    {
+        const auto* const p = reinterpret_cast<const char*>(&value);
+        buf.insert(buf.end(), p, p + sizeof(T));
+    }
+
+    void AppendString (std::vector<char>& buf, const std::string& s)
+    {
+        Append(buf, static_cast<std::uint32_t>(s.size()));
+        buf.insert(buf.end(), s.begin(), s.end());
+    }
+
+    void AppendBytes (std::vector<char>& buf, const void* data, std::size_t nbytes)
+    {
+        const auto* const p = static_cast<const char*>(data);
+        buf.insert(buf.end(), p, p + nbytes);
+    }
+}
+
+/** Shared-memory ring buffer or Unix-domain socket of one rank */
+class FlushFormatStream::Transport
+{
+public:
+    Transport (const std::string& type, const std::string& name,
+               int ring_size, std::uint64_t slot_size, double connect_timeout);
+    ~Transport ();
+
+    Transport ( Transport const &)             = delete;
+    Transport& operator= ( Transport const & ) = delete;
+    Transport ( Transport&& )                  = delete;
+    Transport& operator= ( Transport&& )       = delete;
+
+    /** Publish a message; return false if it was dropped because the consumer is behind */
+    bool Send (const std::vector<char>& message, bool block_when_full);
+
+private:
+    bool m_is_shm = true;
+    std::string m_name;
+    int m_fd = -1;
+    void* m_mapped = nullptr;
+    std::size_t m_mapped_size = 0;
+    RingHeader* m_header = nullptr;
+    char* m_slots = nullptr;
+    std::uint64_t m_slot_size = 0;
+    std::uint64_t m_ring_size = 0;
+};
+
+#ifdef _WIN32
+
+FlushFormatStream::Transport::Transport (const std::string&, const std::string&,
+                                         int, std::uint64_t, double)
+{
+    WARPX_ABORT_WITH_MESSAGE("The stream diagnostics format is not supported on Windows");
+}
+
+FlushFormatStream::Transport::~Transport () = default;
+
+bool
+FlushFormatStream::Transport::Send (const std::vector<char>&, bool)
+{
+    return false;
+}
+
+#else
+
+FlushFormatStream::Transport::Transport (const std::string& type, const std::string& name,
+                                         int ring_size, std::uint64_t slot_size,
+                                         double connect_timeout)
+    : m_is_shm{type == "shm"}, m_name{name},
+      m_slot_size{slot_size}, m_ring_size{static_cast<std::uint64_t>(ring_size)}
+{
+    if (m_is_shm) {
+        m_fd = shm_open(m_name.c_str(), O_CREAT | O_RDWR | O_TRUNC, S_IRUSR | S_IWUSR);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_fd >= 0,
+            "Could not create the shared-memory object " + m_name + ": " + std::strerror(errno));
+        m_mapped_size = ring_header_size + m_ring_size * m_slot_size;
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ftruncate(m_fd, static_cast<off_t>(m_mapped_size)) == 0,
+            "Could not allocate the shared-memory object " + m_name + ": " + std::strerror(errno));
+        m_mapped = mmap(nullptr, m_mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_mapped != MAP_FAILED,
+            "Could not map the shared-memory object " + m_name + ": " + std::strerror(errno));
+
+        m_header = new (m_mapped) RingHeader{};
+        m_header->version = stream_version;
+        m_header->ring_size = static_cast<std::uint32_t>(m_ring_size);
+        m_header->slot_size = m_slot_size;
+        m_header->head.store(0, std::memory_order_relaxed);
+        m_header->tail.store(0, std::memory_order_relaxed);
+        m_header->closed.store(0, std::memory_order_relaxed);
+        m_slots = static_cast<char*>(m_mapped) + ring_header_size;
+        // the magic is written last, so that a consumer polling it sees a complete header
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(m_header->magic, "WARPXRNG", 8);
+    } else {
+        m_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_fd >= 0,
+            std::string("Could not create a Unix-domain socket: ") + std::strerror(errno));
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_name.size() < sizeof(addr.sun_path),
+            "The socket path " + m_name + " is too long");
+        std::strncpy(addr.sun_path, m_name.c_str(), sizeof(addr.sun_path) - 1);
+
+        // the consumer creates the socket: wait for it to listen
+        auto const start = std::chrono::steady_clock::now();
+        while (connect(m_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(elapsed.count() < connect_timeout,
+                "Could not connect to the socket " + m_name + ": " + std::strerror(errno));
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+#ifdef SO_NOSIGPIPE
+        int const one = 1;
+        setsockopt(m_fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    }
+}
+
+FlushFormatStream::Transport::~Transport ()
+{
+    if (m_is_shm && m_header) {
+        // The shared-memory object is not unlinked, so that the consumer can read the
+        // remaining messages after the end of the simulation; it is removed by the consumer.
+        m_header->closed.store(1, std::memory_order_release);
+        munmap(m_mapped, m_mapped_size);
+    }
+    if (m_fd >= 0) { close(m_fd); }
+}
+
+bool
+FlushFormatStream::Transport::Send (const std::vector<char>& message, bool block_when_full)
+{
+    if (m_is_shm) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(message.size() <= m_slot_size,
+            "The stream message (" + std::to_string(message.size()) +
+            " bytes) does not fit in a slot of the ring buffer " + m_name +
+            ": increase <diag>.stream.slot_size");
+        const std::uint64_t head = m_header->head.load(std::memory_order_relaxed);
+        while (head - m_header->tail.load(std::memory_order_acquire) >= m_ring_size) {
+            if (!block_when_full) { return false; }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        std::memcpy(m_slots + (head % m_ring_size) * m_slot_size, message.data(), message.size());
+        m_header->head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+#ifdef MSG_NOSIGNAL
+    int const flags = MSG_NOSIGNAL;
+#else
+    int const flags = 0;
+#endif
+    std::size_t sent = 0;
+    while (sent < message.size()) {
+        // when dropping is allowed, only the start of a message may be skipped
+        int const dont_wait = (!block_when_full && sent == 0) ? MSG_DONTWAIT : 0;
+        const ssize_t n = send(m_fd, message.data() + sent, message.size() - sent, flags | dont_wait);
+        if (n < 0) {
+            if (errno == EINTR) { continue; }
+            if (dont_wait && (errno == EAGAIN || errno == EWOULDBLOCK)) { return false; }
+            WARPX_ABORT_WITH_MESSAGE("Could not send the stream message to the socket " +
+                                     m_name + ": " + std::strerror(errno));
+        }
+        sent += static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+#endif
+
+FlushFormatStream::FlushFormatStream (const std::string& diag_name)
+    : m_diag_name{diag_name}, m_endpoint_name{"warpx_" + diag_name}
+{
+    const amrex::ParmParse pp_diag_name(diag_name);
+    pp_diag_name.query("stream.transport", m_transport_type);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_transport_type == "shm" || m_transport_type == "socket",
+        diag_name + ".stream.transport must be shm or socket");
+    pp_diag_name.query("stream.name", m_endpoint_name);
+    utils::parser::queryWithParser(pp_diag_name, "stream.ring_size", m_ring_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_ring_size > 0,
+        diag_name + ".stream.ring_size must be positive");
+    amrex::Long slot_size = static_cast<amrex::Long>(m_slot_size);
+    utils::parser::queryWithParser(pp_diag_name, "stream.slot_size", slot_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(slot_size > 0,
+        diag_name + ".stream.slot_size must be positive");
+    m_slot_size = static_cast<std::uint64_t>(slot_size);
+    pp_diag_name.query("stream.block_when_full", m_block_when_full);
+    utils::parser::queryWithParser(pp_diag_name, "stream.connect_timeout", m_connect_timeout);
+}
+
+FlushFormatStream::~FlushFormatStream () = default;
+FlushFormatStream::FlushFormatStream ( FlushFormatStream&& ) noexcept = default;
+FlushFormatStream& FlushFormatStream::operator= ( FlushFormatStream&& ) noexcept = default;
+
+void
+FlushFormatStream::WriteToFile (
+    const amrex::Vector<std::string>& varnames,
+    const amrex::Vector<amrex::MultiFab>& mf,
+    amrex::Vector<amrex::Geometry>& geom,
+    const amrex::Vector<int> iteration, const double time,
+    const amrex::Vector<ParticleDiag>& particle_diags, int nlev,
+    const std::string /*prefix*/, int /*file_min_digits*/,
+    bool /*plot_raw_fields*/,
+    bool /*plot_raw_fields_guards*/,
+    const bool /*use_pinned_pc*/,
+    bool /*isBTD*/, int /*snapshotID*/,  int /*bufferID*/, int /*numBuffers*/,
+    const amrex::Geometry& /*full_BTD_snapshot*/,
+    bool /*isLastBTDFlush*/) const
+{
+    WARPX_PROFILE("FlushFormatStream::WriteToFile()");
+
+    auto const wt = amrex::second();
+
+    PackMessage(varnames, mf, geom, iteration[0], time, particle_diags, nlev);
+
+    if (!m_transport) {
+        // one endpoint per rank
+        const int myproc = amrex::ParallelDescriptor::MyProc();
+        std::string name = m_endpoint_name + "_" + std::to_string(myproc);
+        if (m_transport_type == "shm") {
+            name = "/" + name;
+        } else {
+            name += ".sock";
+        }
+        m_transport = std::make_unique<Transport>(m_transport_type, name, m_ring_size,
+                                                  m_slot_size, m_connect_timeout);
+    }
+    const bool sent = m_transport->Send(m_message, m_block_when_full);
+
+    if (WarpX::GetInstance().Verbose()) {
+        double stream_time = amrex::second() - wt;
+        auto nbytes = static_cast<amrex::Long>(m_message.size());
+        int ndropped = sent ? 0 : 1;
+        amrex::ParallelDescriptor::ReduceRealMax(stream_time);
+        amrex::ParallelDescriptor::ReduceLongSum(nbytes);
+        amrex::ParallelDescriptor::ReduceIntSum(ndropped);
+        std::stringstream ss;
+        ss << "Streaming " << m_diag_name << " at iteration " << iteration[0] << ": "
+           << nbytes << " bytes in " << stream_time << " s";
+        if (ndropped > 0) {
+            ss << ", dropped on " << ndropped << " ranks because the consumer is behind";
+        }
+        amrex::Print() << Utils::TextMsg::Info(ss.str());
+    }
+}
+
+void
+FlushFormatStream::PackMessage (
+    const amrex::Vector<std::string>& varnames,
+    const amrex::Vector<amrex::MultiFab>& mf,
+    const amrex::Vector<amrex::Geometry>& geom,
+    int iteration, double time,
+    const amrex::Vector<ParticleDiag>& particle_diags, int nlev) const
+{
+    auto& buf = m_message;
+    buf.clear();
+
+    // message size, filled at the end
+    Append(buf, std::uint64_t(0));
+    AppendBytes(buf, "WARPXSTM", 8);
+    Append(buf, stream_version);
+    Append(buf, static_cast<std::uint32_t>(sizeof(amrex::Real)));
+    Append(buf, static_cast<std::uint32_t>(sizeof(amrex::ParticleReal)));
+    Append(buf, static_cast<std::int32_t>(amrex::ParallelDescriptor::MyProc()));
+    Append(buf, static_cast<std::int32_t>(amrex::ParallelDescriptor::NProcs()));
+    Append(buf, static_cast<std::int64_t>(iteration));
+    Append(buf, time);
+    Append(buf, static_cast<std::int32_t>(AMREX_SPACEDIM));
+    Append(buf, static_cast<std::int32_t>(nlev));
+    const auto ncomp = static_cast<int>(varnames.size());
+    Append(buf, static_cast<std::int32_t>(ncomp));
+    for (auto const& name : varnames) { AppendString(buf, name); }
+
+    // fields: the valid cells of the local boxes, copied through pinned memory
+    for (int lev = 0; lev < nlev; ++lev) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            Append(buf, static_cast<double>(geom[lev].ProbLo(idim)));
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            Append(buf, static_cast<double>(geom[lev].ProbHi(idim)));
+        }
+        const amrex::Box& domain = geom[lev].Domain();
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            Append(buf, static_cast<std::int32_t>(domain.smallEnd(idim)));
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            Append(buf, static_cast<std::int32_t>(domain.bigEnd(idim)));
+        }
+        Append(buf, static_cast<std::int32_t>(mf[lev].local_size()));
+        for (amrex::MFIter mfi(mf[lev]); mfi.isValid(); ++mfi) {
+            const amrex::Box& bx = mfi.validbox();
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                Append(buf, static_cast<std::int32_t>(bx.smallEnd(idim)));
+            }
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                Append(buf, static_cast<std::int32_t>(bx.bigEnd(idim)));
+            }
+            amrex::FArrayBox host_fab(bx, ncomp, amrex::The_Pinned_Arena());
+            host_fab.copy<amrex::RunOn::Device>(mf[lev][mfi], bx, 0, bx, 0, ncomp);
+            amrex::Gpu::streamSynchronize();
+            AppendBytes(buf, host_fab.dataPtr(), host_fab.nBytes());
+        }
+    }
+
+    // particles: only the selected particles of each species, in SI units
+    Append(buf, static_cast<std::int32_t>(particle_diags.size()));
+    for (auto const& part_diag : particle_diags) {
+        WarpXParticleContainer* pc = part_diag.getParticleContainer();
+        auto tmp = pc->make_alike<amrex::PinnedArenaAllocator>();
+        // SelectParticles converts the selected particles (and only them) to SI units,
+        // as for the plotfile and openPMD writers: tmp must not be converted again here
+        part_diag.SelectParticles(tmp, *pc, static_cast<amrex::Real>(time));
+
+        // names of the real components, positions first
+#if defined(WARPX_DIM_1D_Z)
+        amrex::Vector<std::string> real_names = {"z"};
+#elif defined(WARPX_DIM_XZ)
+        amrex::Vector<std::string> real_names = {"x", "z"};
+#elif defined(WARPX_DIM_RZ)
+        amrex::Vector<std::string> real_names = {"r", "z"};
+#else
+        amrex::Vector<std::string> real_names = {"x", "y", "z"};
+#endif
+        real_names.push_back("weight");
+        real_names.push_back("momentum_x");
+        real_names.push_back("momentum_y");
+        real_names.push_back("momentum_z");
+#ifdef WARPX_DIM_RZ
+        real_names.push_back("theta");
+#endif
+        real_names.resize(tmp.NumRealComps());
+        for (auto const& x : tmp.getParticleRuntimeComps()) {
+            real_names[x.second + PIdx::nattribs] = x.first;
+        }
+        amrex::Vector<std::string> int_names(tmp.NumIntComps());
+        for (auto const& x : tmp.getParticleRuntimeiComps()) { int_names[x.second] = x.first; }
+
+        // the positions are always sent, the other attributes following <diag>.<species>.variables
+        amrex::Vector<int> real_comps;
+        for (int comp = 0; comp < tmp.NumRealComps(); ++comp) {
+            if (comp < AMREX_SPACEDIM ||
+                comp >= static_cast<int>(part_diag.m_plot_flags.size()) ||
+                part_diag.m_plot_flags[comp] == 1) {
+                real_comps.push_back(comp);
+            }
+        }
+
+        amrex::Long np = 0;
+        for (int lev = 0; lev <= tmp.finestLevel(); ++lev) {
+            for (auto const& kv : tmp.GetParticles(lev)) { np += kv.second.numParticles(); }
+        }
+
+        AppendString(buf, part_diag.getSpeciesName());
+        Append(buf, static_cast<std::int64_t>(np));
+        Append(buf, static_cast<std::int32_t>(real_comps.size()));
+        for (auto const comp : real_comps) { AppendString(buf, real_names[comp]); }
+        Append(buf, static_cast<std::int32_t>(int_names.size()));
+        for (auto const& name : int_names) { AppendString(buf, name); }
+
+        // the particle data is in pinned memory, directly readable on the host
+        for (auto const comp : real_comps) {
+            for (int lev = 0; lev <= tmp.finestLevel(); ++lev) {
+                for (auto const& kv : tmp.GetParticles(lev)) {
+                    auto const& soa = kv.second.GetStructOfArrays();
+                    AppendBytes(buf, soa.GetRealData(comp).data(),
+                                soa.GetRealData(comp).size() * sizeof(amrex::ParticleReal));
+                }
+            }
+        }
+        for (int lev = 0; lev <= tmp.finestLevel(); ++lev) {
+            for (auto const& kv : tmp.GetParticles(lev)) {
+                auto const& soa = kv.second.GetStructOfArrays();
+                AppendBytes(buf, soa.GetIdCPUData().data(),
+                            soa.GetIdCPUData().size() * sizeof(std::uint64_t));
+            }
+        }
+        for (int comp = 0; comp < tmp.NumIntComps(); ++comp) {
+            for (int lev = 0; lev <= tmp.finestLevel(); ++lev) {
+                for (auto const& kv : tmp.GetParticles(lev)) {
+                    auto const& soa = kv.second.GetStructOfArrays();
+                    AppendBytes(buf, soa.GetIntData(comp).data(),
+                                soa.GetIntData(comp).size() * sizeof(int));
+                }
+            }
+        }
+    }
+
+    const auto message_size = static_cast<std::uint64_t>(buf.size() - sizeof(std::uint64_t));
+    std::memcpy(buf.data(), &message_size, sizeof(message_size));
+}
@@ -15,9 +15,12 @@
 #include "FieldSolver/Fields.H"
 #include "FlushFormats/FlushFormat.H"
 #include "Particles/MultiParticleContainer.H"
+#include "Particles/Pusher/GetAndSetPosition.H"
+#include "Particles/WarpXParticleContainer.H"
 #include "Utils/Algorithms/IsIn.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <AMReX.H>
@@ -25,6 +28,7 @@
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_CoordSys.H>
 #include <AMReX_DistributionMapping.H>
@@ -32,7 +36,9 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_MakeType.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelReduce.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_ParticleReduce.H>
 #include <AMReX_REAL.H>
 #include <AMReX_RealBox.H>
 #include <AMReX_Vector.H>
@@ -40,6 +46,7 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <utility>
 #include <vector>
 
 using namespace amrex::literals;
@@ -90,8 +97,8 @@ FullDiagnostics::ReadParameters ()
     WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
         m_format == "plotfile" || m_format == "openpmd" ||
         m_format == "checkpoint" || m_format == "ascent" ||
-        m_format == "sensei" || m_format == "catalyst",
-        "<diag>.format must be plotfile or openpmd or checkpoint or ascent or catalyst or sensei");
+        m_format == "sensei" || m_format == "catalyst" || m_format == "stream",
+        "<diag>.format must be plotfile or openpmd or checkpoint or ascent or catalyst or sensei or stream");
     std::vector<std::string> intervals_string_vec = {"0"};
     pp_diag_name.getarr("intervals", intervals_string_vec);
     m_intervals = utils::parser::IntervalsParser(intervals_string_vec);
@@ -105,10 +112,13 @@ FullDiagnostics::ReadParameters ()
     amrex::ignore_unused(m_dump_rz_modes);
 #endif
 
+    pp_diag_name.query("roi_track_species", m_roi_track_species);
+
     if (m_format == "checkpoint"){
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             raw_specified == false &&
-            checkpoint_compatibility == true,
+            checkpoint_compatibility == true &&
+            m_roi_track_species.empty(),
             "For a checkpoint output, cannot specify these parameters as all data must be dumped "
             "to file for a restart");
     }
@@ -136,11 +146,14 @@ FullDiagnostics::Flush ( int i_buffer, bool /* force_flush */ )
     // is supported for BackTransformed Diagnostics, in BTDiagnostics class.
     auto & warpx = WarpX::GetInstance();
 
+    m_field_compression.Apply(m_mf_output.at(i_buffer), nlev_output);
+
     m_flush_format->WriteToFile(
         m_varnames, m_mf_output.at(i_buffer), m_geom_output.at(i_buffer), warpx.getistep(),
         warpx.gett_new(0),
         m_output_species.at(i_buffer), nlev_output, m_file_prefix,
         m_file_min_digits, m_plot_raw_fields, m_plot_raw_fields_guards);
+    m_field_compression.RecordOutput(m_flush_format->FieldBytesWritten());
 
     FlushRaw();
 }
@@ -579,22 +592,43 @@ FullDiagnostics::InitializeBufferData (int i_buffer, int lev, bool restart ) {
 
         // Box for the output MultiFab corresponding to the user-defined physical co-ordinates at lev.
         const amrex::Box diag_box( lo, hi );
-        // Define box array
-        amrex::BoxArray diag_ba;
-        diag_ba.define(diag_box);
-        ba = diag_ba.maxSize( warpx.maxGridSize( lev ) );
-        // At this point in the code, the BoxArray, ba, is defined with the same index space and
-        // resolution as the simulation, at level, lev.
-        // Coarsen and refine so that the new BoxArray is coarsenable.
-        ba.coarsen(m_crse_ratio).refine(m_crse_ratio);
+        if (lev == 0) {
+            // Region of interest: the output BoxArray is made of the intersections of the
+            // simulation boxes with the (coarsenable) diagnostic box, and keeps the
+            // DistributionMapping of the simulation. The diagnostic functors then only
+            // interpolate the boxes that intersect the region, without communication.
+            const amrex::Box roi_box = amrex::Box(diag_box).coarsen(m_crse_ratio).refine(m_crse_ratio);
+            amrex::BoxList roi_bl;
+            amrex::Vector<int> roi_pmap;
+            for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+                const amrex::Box b = ba[i] & roi_box;
+                if (b.ok()) {
+                    roi_bl.push_back(b);
+                    roi_pmap.push_back(dmap[i]);
+                }
+            }
+            ba = amrex::BoxArray(std::move(roi_bl));
+            dmap = amrex::DistributionMapping(std::move(roi_pmap));
+        } else {
+            // Define box array
+            amrex::BoxArray diag_ba;
+            diag_ba.define(diag_box);
+            ba = diag_ba.maxSize( warpx.maxGridSize( lev ) );
+            // At this point in the code, the BoxArray, ba, is defined with the same index space and
+            // resolution as the simulation, at level, lev.
+            // Coarsen and refine so that the new BoxArray is coarsenable.
+            ba.coarsen(m_crse_ratio).refine(m_crse_ratio);
+            dmap = amrex::DistributionMapping{ba};
+        }
 
         // Update the physical co-ordinates m_lo and m_hi using the final index values
         // from the coarsenable, cell-centered BoxArray, ba.
+        const amrex::Box ba_box = ba.minimalBox();
         for ( int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
             diag_dom.setLo( idim, warpx.Geom(lev).ProbLo(idim) +
-                ba.getCellCenteredBox(0).smallEnd(idim) * warpx.Geom(lev).CellSize(idim));
+                ba_box.smallEnd(idim) * warpx.Geom(lev).CellSize(idim));
             diag_dom.setHi( idim, warpx.Geom(lev).ProbLo(idim) +
-                (ba.getCellCenteredBox( static_cast<int>(ba.size())-1 ).bigEnd(idim) + 1) * warpx.Geom(lev).CellSize(idim));
+                (ba_box.bigEnd(idim) + 1) * warpx.Geom(lev).CellSize(idim));
         }
     }
 
@@ -602,9 +636,6 @@ FullDiagnostics::InitializeBufferData (int i_buffer, int lev, bool restart ) {
         m_crse_ratio.min() > 0, "Coarsening ratio must be non-zero.");
     // The BoxArray is coarsened based on the user-defined coarsening ratio.
     ba.coarsen(m_crse_ratio);
-    // Generate a new distribution map if the physical m_lo and m_hi for the output
-    // is different from the lo and hi physical co-ordinates of the simulation domain.
-    if (!use_warpxba) { dmap = amrex::DistributionMapping{ba}; }
     // Allocate output MultiFab for diagnostics. The data will be stored at cell-centers.
     const int ngrow = (m_format == "sensei" || m_format == "ascent") ? 1 : 0;
     int const ncomp = static_cast<int>(m_varnames.size());
@@ -772,6 +803,8 @@ FullDiagnostics::InitializeFieldFunctors (int lev)
 void
 FullDiagnostics::PrepareFieldDataForOutput ()
 {
+    if (!m_roi_track_species.empty()) { TrackRegionOfInterest(); }
+
     // First, make sure all guard cells are properly filled
     // Probably overkill/unnecessary, but safe and shouldn't happen often !!
     auto & warpx = WarpX::GetInstance();
@@ -863,3 +896,78 @@ FullDiagnostics::MovingWindowAndGalileanDomainShift (int step)
 
 
 }
+
+void
+FullDiagnostics::TrackRegionOfInterest ()
+{
+    WARPX_PROFILE("FullDiagnostics::TrackRegionOfInterest()");
+
+    auto & warpx = WarpX::GetInstance();
+    auto const & pc = warpx.GetPartContainer().GetParticleContainerFromName(m_roi_track_species);
+
+    // Weighted sum of the particle positions
+    using PType = typename WarpXParticleContainer::SuperParticleType;
+    amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum,
+                     amrex::ReduceOpSum, amrex::ReduceOpSum> reduce_ops;
+    using ReduceDataT = amrex::ReduceData<amrex::ParticleReal, amrex::ParticleReal,
+                                          amrex::ParticleReal, amrex::ParticleReal>;
+    auto r = amrex::ParticleReduce<ReduceDataT>(
+        pc,
+        [=] AMREX_GPU_DEVICE (const PType& p) noexcept -> ReduceDataT::Type
+        {
+            const amrex::ParticleReal w = p.rdata(PIdx::w);
+            amrex::ParticleReal x, y, z;
+            get_particle_position(p, x, y, z);
+            return {w, w*x, w*y, w*z};
+        },
+        reduce_ops);
+    amrex::Vector<amrex::ParticleReal> sums = {
+        amrex::get<0>(r), amrex::get<1>(r), amrex::get<2>(r), amrex::get<3>(r)};
+    amrex::ParallelAllReduce::Sum(
+        sums.data(), static_cast<int>(sums.size()), amrex::ParallelDescriptor::Communicator());
+    // Keep the current region of interest if the species has no particles
+    if (sums[0] <= 0._prt) { return; }
+
+    // Centroid along each direction of the index space (the radial
+    // extent is not tracked in RZ geometry)
+    amrex::Vector<amrex::Real> centroid(AMREX_SPACEDIM);
+    amrex::Vector<bool> track_dir(AMREX_SPACEDIM, true);
+#if defined(WARPX_DIM_3D)
+    centroid[0] = static_cast<amrex::Real>(sums[1] / sums[0]);
+    centroid[1] = static_cast<amrex::Real>(sums[2] / sums[0]);
+    centroid[2] = static_cast<amrex::Real>(sums[3] / sums[0]);
+#elif defined(WARPX_DIM_XZ) || defined(WARPX_DIM_RZ)
+    centroid[0] = static_cast<amrex::Real>(sums[1] / sums[0]);
+    centroid[1] = static_cast<amrex::Real>(sums[3] / sums[0]);
+#   if defined(WARPX_DIM_RZ)
+    track_dir[0] = false;
+#   endif
+#elif defined(WARPX_DIM_1D_Z)
+    centroid[0] = static_cast<amrex::Real>(sums[3] / sums[0]);
+#endif
+
+    // Move the region of interest, keeping its size, within the simulation domain
+    const amrex::Geometry& geom = warpx.Geom(0);
+    const amrex::RealBox& current_dom = m_geom_output[0][0].ProbDomain();
+    const amrex::Real* dx_output = m_geom_output[0][0].CellSize();
+    bool moved = false;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_lo[idim] = current_dom.lo(idim);
+        m_hi[idim] = current_dom.hi(idim);
+        if (!track_dir[idim]) { continue; }
+        const amrex::Real width = current_dom.hi(idim) - current_dom.lo(idim);
+        amrex::Real new_lo = centroid[idim] - 0.5_rt*width;
+        new_lo = std::max(geom.ProbLo(idim), std::min(new_lo, geom.ProbHi(idim) - width));
+        if (std::abs(new_lo - current_dom.lo(idim)) >= dx_output[idim]) {
+            m_lo[idim] = new_lo;
+            m_hi[idim] = new_lo + width;
+            moved = true;
+        }
+    }
+    if (!moved) { return; }
+
+    // Re-define the output MultiFabs and geometry on the new region of interest
+    for (int lev = 0; lev < nlev_output; ++lev) {
+        InitializeBufferData(0, lev);
+    }
+}
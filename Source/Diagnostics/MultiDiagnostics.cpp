@@ -112,3 +112,11 @@ MultiDiagnostics::NewIteration ()
         diag->NewIteration();
     }
 }
+
+void
+MultiDiagnostics::PrintReport () const
+{
+    for( auto const& diag : alldiags ){
+        diag->PrintReport();
+    }
+}
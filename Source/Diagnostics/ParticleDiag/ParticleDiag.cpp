@@ -1,19 +1,242 @@
 #include "ParticleDiag.H"
 
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
+#include "Particles/Filter/FilterFunctors.H"
+#include "Particles/ParticleIO.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
+#include "Utils/WarpXConst.H"
+#include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <ablastr/warn_manager/WarnManager.H>
 
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_ParticleTransformation.H>
+#include <AMReX_Scan.H>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
 #include <map>
+#include <random>
+#include <set>
 #include <vector>
 
 using namespace amrex;
+using namespace amrex::literals;
+
+namespace
+{
+    /** Combination of all the particle diagnostics filters */
+    struct CombinedFilter
+    {
+        RandomFilter m_random_filter;
+        UniformFilter m_uniform_filter;
+        ParserFilter m_parser_filter;
+        GeometryFilter m_geometry_filter;
+        HashRandomFilter m_sample_filter;
+
+        AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+        bool operator () (const SuperParticleType& p, const amrex::RandomEngine& engine) const noexcept
+        {
+            return m_random_filter(p, engine) && m_uniform_filter(p, engine)
+                && m_parser_filter(p, engine) && m_geometry_filter(p, engine)
+                && m_sample_filter(p, engine);
+        }
+    };
+
+    /** Flag the particles of a tile selected by filter and return their number
+     *
+     * \param[in] ptile_src particle tile
+     * \param[in] filter selection functor
+     * \param[out] Flag 1 for the selected particles, 0 otherwise
+     * \param[out] Index index of each selected particle among the selected particles
+     */
+    template <typename SrcTile>
+    int FlagParticles (SrcTile const& ptile_src, CombinedFilter const& filter,
+                       int* Flag, int* Index)
+    {
+        const auto np = static_cast<int>(ptile_src.numParticles());
+        const auto src_data = ptile_src.getConstParticleTileData();
+        amrex::ParallelForRNG(np,
+            [=] AMREX_GPU_DEVICE (int i, amrex::RandomEngine const& engine)
+            {
+                const SuperParticleType& p = src_data.getSuperParticle(i);
+                Flag[i] = filter(p, engine) ? 1 : 0;
+            });
+        return amrex::Scan::ExclusiveSum(np, Flag, Index);
+    }
+
+    template <typename SrcPC>
+    void SelectParticlesImpl (ParticleDiag const& diag,
+                              PinnedMemoryParticleContainer& dst, const SrcPC& src,
+                              amrex::Real time, std::uint64_t seed, std::uint64_t selection_index)
+    {
+        WARPX_PROFILE("ParticleDiag::SelectParticles()");
+
+        const WarpXParticleContainer* pc = diag.getParticleContainer();
+        ParserFilter parser_filter(diag.m_do_parser_filter,
+                                   utils::parser::compileParser<ParticleDiag::m_nvars>
+                                       (diag.m_particle_filter_parser.get()),
+                                   pc->getMass(), time);
+        // The source particles are not converted to SI units before the selection
+        parser_filter.m_units = InputUnits::WarpX;
+        auto const make_filter = [&] (bool do_sample, amrex::Real sample_fraction)
+        {
+            return CombinedFilter{
+                RandomFilter(diag.m_do_random_filter, diag.m_random_fraction),
+                UniformFilter(diag.m_do_uniform_filter, diag.m_uniform_stride),
+                parser_filter,
+                GeometryFilter(diag.m_do_geom_filter, diag.m_diag_domain),
+                HashRandomFilter(do_sample, sample_fraction, seed)};
+        };
+
+        amrex::Gpu::DeviceVector<int> FlagForPartCopy;
+        amrex::Gpu::DeviceVector<int> IndexForPartCopy;
+
+        // With a target count, draw a uniform sample among the particles that pass the
+        // other filters: each particle is selected with a probability slightly larger
+        // than target_count/n_pass (with a hash of its id, so that the selection is the
+        // same in every pass below), and the excess particles are then removed uniformly.
+        bool do_sample = false;
+        amrex::Real sample_fraction = 1.0_rt;
+        if (diag.m_do_target_count) {
+            CombinedFilter const pass_filter = make_filter(false, 1.0_rt);
+            amrex::Long n_pass = 0;
+            for (int lev = 0; lev <= src.finestLevel(); ++lev) {
+                for (auto const& kv : src.GetParticles(lev)) {
+                    FlagForPartCopy.resize(kv.second.numParticles());
+                    IndexForPartCopy.resize(kv.second.numParticles());
+                    n_pass += FlagParticles(kv.second, pass_filter,
+                                            FlagForPartCopy.dataPtr(), IndexForPartCopy.dataPtr());
+                }
+            }
+            amrex::ParallelAllReduce::Sum(n_pass, amrex::ParallelDescriptor::Communicator());
+
+            if (n_pass > diag.m_target_count) {
+                // Margin of 3 standard deviations, so that at least target_count
+                // particles are drawn with a high probability
+                auto const target = static_cast<amrex::Real>(diag.m_target_count);
+                sample_fraction = std::min(1.0_rt,
+                    (target + 3.0_rt*std::sqrt(target) + 1.0_rt) / static_cast<amrex::Real>(n_pass));
+                do_sample = true;
+            }
+        }
+        CombinedFilter const filter = make_filter(do_sample, sample_fraction);
+
+        std::vector<amrex::Long> removed_ordinals;
+        std::vector<int> tile_counts;
+        if (do_sample) {
+            // Number of sampled particles, per tile and per process
+            amrex::Long n_local = 0;
+            for (int lev = 0; lev <= src.finestLevel(); ++lev) {
+                for (auto const& kv : src.GetParticles(lev)) {
+                    FlagForPartCopy.resize(kv.second.numParticles());
+                    IndexForPartCopy.resize(kv.second.numParticles());
+                    tile_counts.push_back(FlagParticles(kv.second, filter,
+                        FlagForPartCopy.dataPtr(), IndexForPartCopy.dataPtr()));
+                    n_local += tile_counts.back();
+                }
+            }
+            const int nprocs = amrex::ParallelDescriptor::NProcs();
+            const int myproc = amrex::ParallelDescriptor::MyProc();
+            amrex::Vector<amrex::Long> n_per_proc(nprocs, 0);
+            n_per_proc[myproc] = n_local;
+            amrex::ParallelAllReduce::Sum(n_per_proc.data(), nprocs,
+                                          amrex::ParallelDescriptor::Communicator());
+            amrex::Long n_sampled = 0;
+            amrex::Long offset = 0;
+            for (int iproc = 0; iproc < nprocs; ++iproc) {
+                if (iproc == myproc) { offset = n_sampled; }
+                n_sampled += n_per_proc[iproc];
+            }
+
+            // Draw the sampled particles to remove with Floyd's algorithm. All the
+            // processes use the same seed, hence draw the same global ordinals.
+            const amrex::Long n_excess = n_sampled - diag.m_target_count;
+            if (n_excess > 0) {
+                std::mt19937_64 rng(seed + selection_index);
+                std::set<amrex::Long> removed;
+                for (amrex::Long j = n_sampled - n_excess; j < n_sampled; ++j) {
+                    const amrex::Long t = std::uniform_int_distribution<amrex::Long>(0, j)(rng);
+                    if (!removed.insert(t).second) { removed.insert(j); }
+                }
+                for (auto const ordinal : removed) {
+                    if (ordinal >= offset && ordinal < offset + n_local) {
+                        removed_ordinals.push_back(ordinal - offset);
+                    }
+                }
+            }
+        }
+
+        // Selection and stream compaction of the particles in dst
+        amrex::Gpu::DeviceVector<int> removed_in_tile;
+        amrex::Long tile_offset = 0;
+        std::size_t itile = 0;
+        auto removed_it = removed_ordinals.cbegin();
+        for (int lev = 0; lev <= src.finestLevel(); ++lev) {
+            for (auto const& kv : src.GetParticles(lev)) {
+                auto const& ptile_src = kv.second;
+                const auto np = static_cast<int>(ptile_src.numParticles());
+                FlagForPartCopy.resize(np);
+                IndexForPartCopy.resize(np);
+                int* const AMREX_RESTRICT Flag = FlagForPartCopy.dataPtr();
+                int* const AMREX_RESTRICT IndexLocation = IndexForPartCopy.dataPtr();
+                int n_selected = FlagParticles(ptile_src, filter, Flag, IndexLocation);
+
+                // Unselect the excess particles drawn above that are in this tile
+                if (!tile_counts.empty()) {
+                    std::vector<int> removed_host;
+                    const amrex::Long tile_end = tile_offset + tile_counts[itile];
+                    while (removed_it != removed_ordinals.cend() && *removed_it < tile_end) {
+                        removed_host.push_back(static_cast<int>(*removed_it - tile_offset));
+                        ++removed_it;
+                    }
+                    tile_offset = tile_end;
+                    ++itile;
+                    if (!removed_host.empty()) {
+                        const auto n_removed = static_cast<int>(removed_host.size());
+                        removed_in_tile.resize(n_removed);
+                        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice,
+                            removed_host.begin(), removed_host.end(), removed_in_tile.begin());
+                        int const* const removed_ptr = removed_in_tile.dataPtr();
+                        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i)
+                        {
+                            if (Flag[i] == 0) { return; }
+                            // binary search of this particle in the sorted list of removed particles
+                            int lo = 0;
+                            int hi = n_removed;
+                            while (lo < hi) {
+                                const int mid = (lo + hi) / 2;
+                                if (removed_ptr[mid] < IndexLocation[i]) { lo = mid + 1; }
+                                else { hi = mid; }
+                            }
+                            if (lo < n_removed && removed_ptr[lo] == IndexLocation[i]) { Flag[i] = 0; }
+                        });
+                        n_selected = amrex::Scan::ExclusiveSum(np, Flag, IndexLocation);
+                    }
+                }
+
+                auto& ptile_dst = dst.DefineAndReturnParticleTile(lev, kv.first.first, kv.first.second);
+                ptile_dst.resize(n_selected);
+                if (n_selected > 0) {
+                    amrex::filterParticles(ptile_dst, ptile_src, Flag);
+                }
+                amrex::Gpu::synchronize();
+            }
+        }
+
+        // Only the selected particles are converted to SI units
+        const auto mass = pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
+        particlesConvertUnits(ConvertDirection::WarpX_to_SI, &dst, mass);
+    }
+}
 
 ParticleDiag::ParticleDiag (
     const std::string& diag_name, const std::string& name,
@@ -83,6 +306,15 @@ ParticleDiag::ParticleDiag (
         pp_diag_name_species_name, "random_fraction", m_random_fraction);
     m_do_uniform_filter = utils::parser::queryWithParser(
         pp_diag_name_species_name, "uniform_stride",m_uniform_stride);
+    m_do_target_count = utils::parser::queryWithParser(
+        pp_diag_name_species_name, "target_count", m_target_count);
+    if (m_do_target_count) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_target_count >= 0,
+            diag_name + "." + name + ".target_count must be non-negative");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_do_random_filter,
+            diag_name + "." + name + ".target_count cannot be used with random_fraction");
+        m_target_count_seed = std::hash<std::string>{}(diag_name + "." + name);
+    }
     std::string buf;
     m_do_parser_filter = pp_diag_name_species_name.query("plot_filter_function(t,x,y,z,ux,uy,uz)",
                                                          buf);
@@ -95,3 +327,19 @@ ParticleDiag::ParticleDiag (
             utils::parser::makeParser(function_string,{"t","x","y","z","ux","uy","uz"}));
     }
 }
+
+void
+ParticleDiag::SelectParticles (PinnedMemoryParticleContainer& dst,
+                               const WarpXParticleContainer& src, amrex::Real time) const
+{
+    SelectParticlesImpl(*this, dst, src, time,
+                        m_target_count_seed, m_num_target_count_selections++);
+}
+
+void
+ParticleDiag::SelectParticles (PinnedMemoryParticleContainer& dst,
+                               const PinnedMemoryParticleContainer& src, amrex::Real time) const
+{
+    SelectParticlesImpl(*this, dst, src, time,
+                        m_target_count_seed, m_num_target_count_selections++);
+}
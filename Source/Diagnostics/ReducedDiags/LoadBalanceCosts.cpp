@@ -8,6 +8,7 @@
 
 #include "Diagnostics/ReducedDiags/ReducedDiags.H"
 #include "FieldSolver/Fields.H"
+#include "Parallelization/CostModel.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
@@ -31,6 +32,7 @@
 #include <cstdio>
 #include <iomanip>
 #include <istream>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
@@ -70,6 +72,10 @@ namespace
 LoadBalanceCosts::LoadBalanceCosts (const std::string& rd_name)
     : ReducedDiags{rd_name}
 {
+    if (WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Model)
+    {
+        m_nModelFields = 3;
+    }
 }
 
 // function that gathers costs
@@ -88,7 +94,7 @@ void LoadBalanceCosts::ComputeDiags (int step)
     int nBoxes = 0;
     for (int lev = 0; lev < nLevels; ++lev)
     {
-        auto *const cost = WarpX::getCosts(lev);
+        auto *const cost = WarpX::getParticleCosts(lev);
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             cost, "ERROR: costs are not initialized on level " + std::to_string(lev) + " !");
         nBoxes += cost->size();
@@ -111,7 +117,9 @@ void LoadBalanceCosts::ComputeDiags (int step)
     costs.resize(nLevels);
     for (int lev = 0; lev < nLevels; ++lev)
     {
-        costs[lev] = std::make_unique<LayoutData<Real>>(*WarpX::getCosts(lev));
+        // with algo.load_balance_particles_only, these are the costs of the boxes of the
+        // particles, which are the ones that are load balanced
+        costs[lev] = std::make_unique<LayoutData<Real>>(*WarpX::getParticleCosts(lev));
     }
 
     if (WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Heuristic)
@@ -119,6 +127,19 @@ void LoadBalanceCosts::ComputeDiags (int step)
         warpx.ComputeCostsHeuristic(costs);
     }
 
+    // quality of the fit of the cost model
+    if (m_nModelFields > 0)
+    {
+        m_model_data.assign(m_nModelFields, std::numeric_limits<amrex::Real>::quiet_NaN());
+        CostModel const* model = warpx.GetCostModel();
+        if (model && model->isFitted())
+        {
+            m_model_data[0] = model->RSquared();
+            m_model_data[1] = model->RelativeResidual();
+            m_model_data[2] = static_cast<amrex::Real>(model->nFitBoxes());
+        }
+    }
+
     // keep track of correct index in array over all boxes on all levels
     // shift index for m_data
     int shift_m_data = 0;
@@ -126,11 +147,11 @@ void LoadBalanceCosts::ComputeDiags (int step)
     // save data
     for (int lev = 0; lev < nLevels; ++lev)
     {
-        const amrex::DistributionMapping& dm = warpx.DistributionMap(lev);
+        const amrex::DistributionMapping& dm = costs[lev]->DistributionMap();
         const MultiFab & Ex = warpx.getField(FieldType::Efield_aux, lev,0);
-        for (MFIter mfi(Ex, false); mfi.isValid(); ++mfi)
+        for (MFIter mfi(*costs[lev], false); mfi.isValid(); ++mfi)
         {
-            const Box& tbx = mfi.tilebox();
+            const Box& tbx = amrex::convert(mfi.tilebox(), Ex.ixType());
             m_data[shift_m_data + mfi.index()*m_nDataFields + 0] = (*costs[lev])[mfi.index()];
             m_data[shift_m_data + mfi.index()*m_nDataFields + 1] = dm[mfi.index()];
             m_data[shift_m_data + mfi.index()*m_nDataFields + 2] = lev;
@@ -259,6 +280,12 @@ void LoadBalanceCosts::WriteToFile (int step) const
     // write time
     ofs << WarpX::GetInstance().gett_new(0);
 
+    // write the quality of the fit of the cost model
+    for (const auto& v : m_model_data)
+    {
+        ofs << m_sep << v;
+    }
+
     // loop over data size and write
     for (int i = 0; i < static_cast<int>(m_data.size()); ++i)
     {
@@ -303,6 +330,15 @@ void LoadBalanceCosts::WriteToFile (int step) const
         ofstmp << "[" << c++ << "]step()";
         ofstmp << m_sep;
         ofstmp << "[" << c++ << "]time(s)";
+        if (m_nModelFields > 0)
+        {
+            ofstmp << m_sep;
+            ofstmp << "[" << c++ << "]cost_model_r2()";
+            ofstmp << m_sep;
+            ofstmp << "[" << c++ << "]cost_model_relative_residual()";
+            ofstmp << m_sep;
+            ofstmp << "[" << c++ << "]cost_model_num_boxes()";
+        }
 
         for (int boxNumber=0; boxNumber<m_nBoxesMax; ++boxNumber)
         {
@@ -351,12 +387,12 @@ void LoadBalanceCosts::WriteToFile (int step) const
                 if (ss.peek() == m_sep[0]) { ss.ignore(); }
             }
 
-            // 2 columns for step, time; then nBoxes*nDatafields columns for data;
-            // then nBoxes*1 columns for hostname;
-            // then fill the remaining columns (i.e., up to 2 + m_nBoxesMax*nDataFieldsToWrite)
-            // with NaN, so the array is not jagged
+            // 2 columns for step, time; then m_nModelFields columns for the cost model;
+            // then nBoxes*nDatafields columns for data; then nBoxes*1 columns for hostname;
+            // then fill the remaining columns (i.e., up to 2 + m_nModelFields
+            // + m_nBoxesMax*nDataFieldsToWrite) with NaN, so the array is not jagged
             ofstmp << lineIn;
-            for (int i=0; i<(m_nBoxesMax*nDataFieldsToWrite - (cnt - 2)); ++i)
+            for (int i=0; i<(m_nBoxesMax*nDataFieldsToWrite - (cnt - 2 - m_nModelFields)); ++i)
             {
                 ofstmp << m_sep << "NaN";
             }
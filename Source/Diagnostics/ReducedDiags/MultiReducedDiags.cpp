@@ -23,6 +23,7 @@
 #include "ParticleHistogram2D.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
+#include "ParticleRedistribute.H"
 #include "RhoMaximum.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -68,6 +69,7 @@ MultiReducedDiags::MultiReducedDiags ()
             {"ParticleHistogram",     [](CS s){return std::make_unique<ParticleHistogram>(s);}},
             {"ParticleHistogram2D",   [](CS s){return std::make_unique<ParticleHistogram2D>(s);}},
             {"ParticleNumber",        [](CS s){return std::make_unique<ParticleNumber>(s);}},
+            {"ParticleRedistribute",  [](CS s){return std::make_unique<ParticleRedistribute>(s);}},
             {"ParticleExtrema",       [](CS s){return std::make_unique<ParticleExtrema>(s);}},
             {"ChargeOnEB",  [](CS s){return std::make_unique<ChargeOnEB>(s);}}
     };
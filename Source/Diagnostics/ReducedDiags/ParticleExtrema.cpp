@@ -266,12 +266,15 @@ void ParticleExtrema::ComputeDiags (int step)
                 // define variables in preparation for field gathering
                 const amrex::XDim3 dinv = WarpX::InvCellSize(std::max(lev, 0));
 
-                const amrex::MultiFab & Ex = warpx.getField(FieldType::Efield_aux, lev,0);
-                const amrex::MultiFab & Ey = warpx.getField(FieldType::Efield_aux, lev,1);
-                const amrex::MultiFab & Ez = warpx.getField(FieldType::Efield_aux, lev,2);
-                const amrex::MultiFab & Bx = warpx.getField(FieldType::Bfield_aux, lev,0);
-                const amrex::MultiFab & By = warpx.getField(FieldType::Bfield_aux, lev,1);
-                const amrex::MultiFab & Bz = warpx.getField(FieldType::Bfield_aux, lev,2);
+                // the particles may be on another distribution mapping than the fields
+                // (algo.load_balance_particles_only): gather from fields on the particle grids
+                const auto fields = warpx.GetAuxForParticleGather(lev);
+                const amrex::MultiFab & Ex = *fields[0];
+                const amrex::MultiFab & Ey = *fields[1];
+                const amrex::MultiFab & Ez = *fields[2];
+                const amrex::MultiFab & Bx = *fields[3];
+                const amrex::MultiFab & By = *fields[4];
+                const amrex::MultiFab & Bz = *fields[5];
 
                 // declare reduce_op
                 amrex::ReduceOps<amrex::ReduceOpMin, amrex::ReduceOpMax> reduce_op;
@@ -0,0 +1,118 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "ParticleRedistribute.H"
+
+#include "Diagnostics/ReducedDiags/ReducedDiags.H"
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <ostream>
+#include <vector>
+
+using namespace amrex::literals;
+
+// constructor
+ParticleRedistribute::ParticleRedistribute (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+    // get MultiParticleContainer class object
+    auto & mypc = WarpX::GetInstance().GetPartContainer();
+
+    // the particles are only counted when this diagnostic is used
+    mypc.SetCountRedistributedParticles(true);
+
+    // get number of species (int)
+    const auto nSpecies = mypc.nSpecies();
+
+    // resize data array to 3*(nSpecies+1) (each species + sum over all species
+    // for the moved and sent macroparticles and the bytes sent)
+    m_data.resize(3*(nSpecies+1), 0.0_rt);
+
+    // get species names (std::vector<std::string>)
+    const auto species_names = mypc.GetSpeciesNames();
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]total_moved()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]total_sent()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]total_bytes_sent(B)";
+            for (int i = 0; i < nSpecies; ++i)
+            {
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_moved()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_sent()";
+                ofs << m_sep;
+                ofs << "[" << c++ << "]" << species_names[i] + "_bytes_sent(B)";
+            }
+            ofs << std::endl;
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+// function that sums the particle traffic of the last Redistribute over the MPI ranks
+void ParticleRedistribute::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    // get MultiParticleContainer class object
+    const auto & mypc = WarpX::GetInstance().GetPartContainer();
+
+    // get number of species (int)
+    const auto nSpecies = mypc.nSpecies();
+
+    // statistics of the last Redistribute (empty before the first one)
+    const auto & stats = mypc.GetRedistributeStatistics();
+
+    // moved, sent, bytes sent of each species, then the sums over the species
+    std::vector<amrex::Long> counts(3*(nSpecies+1), 0);
+    for (int i_s = 0; i_s < static_cast<int>(stats.size()); ++i_s)
+    {
+        counts[3*(i_s+1)    ] = stats[i_s].num_moved;
+        counts[3*(i_s+1) + 1] = stats[i_s].num_sent;
+        counts[3*(i_s+1) + 2] = stats[i_s].bytes_sent;
+        counts[0] += stats[i_s].num_moved;
+        counts[1] += stats[i_s].num_sent;
+        counts[2] += stats[i_s].bytes_sent;
+    }
+
+    amrex::ParallelDescriptor::ReduceLongSum(counts.data(), static_cast<int>(counts.size()),
+        amrex::ParallelDescriptor::IOProcessorNumber());
+
+    for (int i = 0; i < static_cast<int>(counts.size()); ++i) {
+        m_data[i] = static_cast<amrex::Real>(counts[i]);
+    }
+
+    /* m_data now contains up-to-date values for:
+     *  [moved, sent, bytes sent (all species),
+     *   moved, sent, bytes sent (species 1),
+     *   ...,
+     *   moved, sent, bytes sent (species n)] */
+}
+// end void ParticleRedistribute::ComputeDiags
@@ -9,7 +9,6 @@
 #include "Particles/ParticleIO.H"
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "FieldIO.H"
-#include "Particles/Filter/FilterFunctors.H"
 #include "Particles/NamedComponentParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/Parser/ParserUtils.H"
@@ -48,6 +47,7 @@
 #include <memory>
 #include <regex>
 #include <set>
+#include <sstream>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -380,14 +380,17 @@ WarpXOpenPMDPlot::WarpXOpenPMDPlot (
     const std::string& engine_type,
     const std::map< std::string, std::string >& engine_parameters,
     const std::vector<bool>& fieldPMLdirections,
-    const std::string& authors)
+    const std::string& authors,
+    FieldCompression field_compression)
     : m_Series(nullptr),
       m_MPIRank{amrex::ParallelDescriptor::MyProc()},
       m_MPISize{amrex::ParallelDescriptor::NProcs()},
       m_Encoding(ie),
       m_OpenPMDFileType{openPMDFileType},
       m_fieldPMLdirections{fieldPMLdirections},
-      m_authors{authors}
+      m_authors{authors},
+      m_operator_type{operator_type},
+      m_field_compression{std::move(field_compression)}
 {
     m_OpenPMDoptions = detail::getSeriesOptions(operator_type, operator_parameters,
                                                 engine_type, engine_parameters);
@@ -545,45 +548,12 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         pinned_pc->make_alike<amrex::PinnedArenaAllocator>() :
         pc->make_alike<amrex::PinnedArenaAllocator>();
 
-    const auto mass = pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
-    RandomFilter const random_filter(particle_diags[i].m_do_random_filter,
-                                     particle_diags[i].m_random_fraction);
-    UniformFilter const uniform_filter(particle_diags[i].m_do_uniform_filter,
-                                       particle_diags[i].m_uniform_stride);
-    ParserFilter parser_filter(particle_diags[i].m_do_parser_filter,
-                               utils::parser::compileParser<ParticleDiag::m_nvars>
-                                     (particle_diags[i].m_particle_filter_parser.get()),
-                                 pc->getMass(), time);
-    parser_filter.m_units = InputUnits::SI;
-    GeometryFilter const geometry_filter(particle_diags[i].m_do_geom_filter,
-                                           particle_diags[i].m_diag_domain);
-
+    // Device-side selection of the particles, with a single stream compaction to
+    // pinned memory of the selected particles, converted to SI units
     if (isBTD || use_pinned_pc) {
-        particlesConvertUnits(ConvertDirection::WarpX_to_SI, pinned_pc, mass);
-        using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-        tmp.copyParticles(*pinned_pc,
-            [random_filter,uniform_filter,parser_filter,geometry_filter]
-            AMREX_GPU_HOST_DEVICE
-            (const SrcData& src, int ip, const amrex::RandomEngine& engine)
-            {
-                const SuperParticleType& p = src.getSuperParticle(ip);
-                return random_filter(p, engine) * uniform_filter(p, engine)
-                        * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
-        particlesConvertUnits(ConvertDirection::SI_to_WarpX, pinned_pc, mass);
+        particle_diags[i].SelectParticles(tmp, *pinned_pc, time);
     } else {
-        particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
-        using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-        tmp.copyParticles(*pc,
-            [random_filter,uniform_filter,parser_filter,geometry_filter]
-            AMREX_GPU_HOST_DEVICE
-            (const SrcData& src, int ip, const amrex::RandomEngine& engine)
-            {
-                const SuperParticleType& p = src.getSuperParticle(ip);
-                return random_filter(p, engine) * uniform_filter(p, engine)
-                        * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
-        particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
+        particle_diags[i].SelectParticles(tmp, *pc, time);
     }
 
     // Gather the electrostatic potential (phi) on the macroparticles
@@ -1210,7 +1180,8 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
                                  std::string const& comp_name,
                                  std::string const& field_name,
                                  amrex::MultiFab const& mf,
-                                 bool var_in_theta_mode) const
+                                 bool var_in_theta_mode,
+                                 amrex::Real abs_error) const
 {
     auto mesh_comp = mesh[comp_name];
     amrex::Box const & global_box = full_geom.Domain();
@@ -1228,8 +1199,17 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
     const std::vector<std::string> axis_labels = detail::getFieldAxisLabels(var_in_theta_mode);
 
     // Prepare the type of dataset that will be written
-    openPMD::Datatype const datatype = openPMD::determineDatatype<amrex::Real>();
-    auto const dataset = openPMD::Dataset(datatype, global_size);
+    openPMD::Datatype const datatype = m_field_compression.SinglePrecision() ?
+        openPMD::determineDatatype<float>() : openPMD::determineDatatype<amrex::Real>();
+    // Per-field error bound for the ADIOS2 operator, overriding the Series-wide parameters
+    std::string dataset_options = "{}";
+    if (abs_error > 0.0 && !m_operator_type.empty() && m_Series->backend() == "ADIOS2") {
+        std::stringstream ss;
+        ss << R"({"adios2": {"dataset": {"operators": [{"type": ")" << m_operator_type
+           << R"(", "parameters": {"accuracy": ")" << abs_error << R"("}}]}}})";
+        dataset_options = ss.str();
+    }
+    auto const dataset = openPMD::Dataset(datatype, global_size, dataset_options);
     mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
     if (var_in_theta_mode) {
         mesh.setGeometry("thetaMode");
@@ -1396,7 +1376,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        m_field_compression.AbsError(varname) );
                     }
                 } else {
                     auto mesh = meshes[field_name];
@@ -1406,7 +1387,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        m_field_compression.AbsError(varname) );
                     }
                 }
             }
@@ -1443,6 +1425,25 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                     chunk_size.emplace(chunk_size.begin(), 1);
                 }
 
+                // single precision output: convert to a temporary host buffer
+                if (m_field_compression.SinglePrecision()) {
+                    auto const npts = static_cast<std::size_t>(local_box.numPts());
+                    std::shared_ptr<float> data_float(new float[npts], std::default_delete<float[]>());
+                    amrex::Real const *local_data = fab.dataPtr(icomp);
+#ifdef AMREX_USE_GPU
+                    amrex::Vector<amrex::Real> data_host;
+                    if (fab.arena()->isManaged() || fab.arena()->isDevice()) {
+                        data_host.resize(npts);
+                        amrex::Gpu::dtoh_memcpy(data_host.data(), local_data, npts*sizeof(amrex::Real));
+                        local_data = data_host.data();
+                    }
+#endif
+                    std::transform(local_data, local_data + npts, data_float.get(),
+                        [](amrex::Real v) { return static_cast<float>(v); });
+                    mesh_comp.storeChunk(data_float, chunk_offset, chunk_size);
+                    continue;
+                }
+
                 // we avoid relying on managed memory by copying explicitly to host
                 //   remove the copies and "streamSynchronize" if you like to pass
                 //   GPU pointers to the I/O library
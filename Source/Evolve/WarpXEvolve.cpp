@@ -35,6 +35,7 @@
 #include "Utils/WarpXConst.H"
 #include "Utils/WarpXProfilerWrapper.H"
 
+#include <ablastr/utils/Communication.H>
 #include <ablastr/utils/SignalHandling.H>
 #include <ablastr/warn_manager/WarnManager.H>
 
@@ -45,6 +46,7 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_LayoutData.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Print.H>
 #include <AMReX_REAL.H>
@@ -55,6 +57,7 @@
 #include <array>
 #include <memory>
 #include <ostream>
+#include <string>
 #include <vector>
 
 using namespace amrex;
@@ -186,7 +189,14 @@ WarpX::Evolve (int numsteps)
                 }
                 UpdateAuxilaryData();
                 FillBoundaryAux(guard_cells.ng_UpdateAux);
+                UpdateAuxOnParticleGrids();
                 for (int lev = 0; lev <= finest_level; ++lev) {
+                    if (!ParticlesOnFieldGrids(lev)) {
+                        auto const& E = Efield_aux_particle_grids[lev];
+                        auto const& B = Bfield_aux_particle_grids[lev];
+                        mypc->PushP(lev, 0.5_rt*dt[lev], *E[0], *E[1], *E[2], *B[0], *B[1], *B[2]);
+                        continue;
+                    }
                     mypc->PushP(lev, 0.5_rt*dt[lev],
                                 *Efield_aux[lev][0],*Efield_aux[lev][1],
                                 *Efield_aux[lev][2],
@@ -311,9 +321,21 @@ WarpX::Evolve (int numsteps)
     if (istep[0] == max_step || (stop_time - 1.e-3*dt[0] <= cur_time && cur_time < stop_time + dt[0])
         || m_exit_loop_due_to_interrupt_signal) {
         multi_diags->FilterComputePackFlushLastTimestep( istep[0] );
+        multi_diags->PrintReport();
         if (m_exit_loop_due_to_interrupt_signal) { ExecutePythonCallback("onbreaksignal"); }
     }
 
+    if (verbose) {
+        auto [num_batched_messages, num_unbatched_messages] =
+            ablastr::utils::communication::FillBoundaryMessageCounts();
+        amrex::ParallelDescriptor::ReduceLongSum(num_batched_messages);
+        amrex::ParallelDescriptor::ReduceLongSum(num_unbatched_messages);
+        amrex::Print() << Utils::TextMsg::Info(
+            "Batched guard-cell exchanges sent " + std::to_string(num_batched_messages)
+            + " messages, instead of " + std::to_string(num_unbatched_messages)
+            + " with one exchange per MultiFab");
+    }
+
     amrex::Print() <<
         ablastr::warn_manager::GetWMInstance().PrintGlobalWarnings("THE END");
 }
@@ -391,22 +413,34 @@ WarpX::OneStep_nosub (Real cur_time)
         FillBoundaryG(guard_cells.ng_FieldSolverG);
 
         EvolveB(0.5_rt * dt[0], DtType::FirstHalf); // We now have B^{n+1/2}
-        FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
-
-        if (WarpX::em_solver_medium == MediumForEM::Vacuum) {
-            // vacuum medium
-            EvolveE(dt[0]); // We now have E^{n+1}
-        } else if (WarpX::em_solver_medium == MediumForEM::Macroscopic) {
-            // macroscopic medium
-            MacroscopicEvolveE(dt[0]); // We now have E^{n+1}
+
+        if (WarpX::do_fdtd_comm_overlap) {
+            // vacuum medium, without F and G (see the checks of warpx.do_fdtd_comm_overlap)
+            FillBoundaryBAndEvolveE(dt[0], guard_cells.ng_FieldSolver); // We now have E^{n+1}
+            FillBoundaryEAndEvolveB(0.5_rt * dt[0], DtType::SecondHalf,
+                                    guard_cells.ng_FieldSolver); // We now have B^{n+1}
+        } else if (WarpX::do_fdtd_temporal_blocking) {
+            // vacuum or macroscopic medium, periodic, without F and G
+            // (see the checks of warpx.do_fdtd_temporal_blocking)
+            FillBoundaryBJAndEvolveEB(dt[0]); // We now have E^{n+1} and B^{n+1}
         } else {
-            WARPX_ABORT_WITH_MESSAGE("Medium for EM is unknown");
-        }
-        FillBoundaryE(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+            FillBoundaryB(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
+
+            if (WarpX::em_solver_medium == MediumForEM::Vacuum) {
+                // vacuum medium
+                EvolveE(dt[0]); // We now have E^{n+1}
+            } else if (WarpX::em_solver_medium == MediumForEM::Macroscopic) {
+                // macroscopic medium
+                MacroscopicEvolveE(dt[0]); // We now have E^{n+1}
+            } else {
+                WARPX_ABORT_WITH_MESSAGE("Medium for EM is unknown");
+            }
+            FillBoundaryE(guard_cells.ng_FieldSolver, WarpX::sync_nodal_points);
 
-        EvolveF(0.5_rt * dt[0], DtType::SecondHalf);
-        EvolveG(0.5_rt * dt[0], DtType::SecondHalf);
-        EvolveB(0.5_rt * dt[0], DtType::SecondHalf); // We now have B^{n+1}
+            EvolveF(0.5_rt * dt[0], DtType::SecondHalf);
+            EvolveG(0.5_rt * dt[0], DtType::SecondHalf);
+            EvolveB(0.5_rt * dt[0], DtType::SecondHalf); // We now have B^{n+1}
+        }
 
         if (do_pml) {
             DampPML();
@@ -458,9 +492,16 @@ void WarpX::ExplicitFillBoundaryEBUpdateAux ()
 
         UpdateAuxilaryData();
         FillBoundaryAux(guard_cells.ng_UpdateAux);
+        UpdateAuxOnParticleGrids();
         // on first step, push p by -0.5*dt
         for (int lev = 0; lev <= finest_level; ++lev)
         {
+            if (!ParticlesOnFieldGrids(lev)) {
+                auto const& E = Efield_aux_particle_grids[lev];
+                auto const& B = Bfield_aux_particle_grids[lev];
+                mypc->PushP(lev, -0.5_rt*dt[lev], *E[0], *E[1], *E[2], *B[0], *B[1], *B[2]);
+                continue;
+            }
             mypc->PushP(lev, -0.5_rt*dt[lev],
                         *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
                         *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2]);
@@ -489,6 +530,7 @@ void WarpX::ExplicitFillBoundaryEBUpdateAux ()
         }
         UpdateAuxilaryData();
         FillBoundaryAux(guard_cells.ng_UpdateAux);
+        UpdateAuxOnParticleGrids();
     }
 }
 
@@ -629,10 +671,14 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
 
     // Initialize multi-J loop:
 
-    // 1) Prepare E,B,F,G fields in spectral space
-    PSATDForwardTransformEB(Efield_fp, Bfield_fp, Efield_cp, Bfield_cp);
-    if (WarpX::do_dive_cleaning) { PSATDForwardTransformF(); }
-    if (WarpX::do_divb_cleaning) { PSATDForwardTransformG(); }
+    // 1) Prepare E,B,F,G fields in spectral space, unless they are still there from
+    //    the previous step (see psatd.keep_fields_in_spectral_space)
+    if (!m_psatd_spectral_fields_current)
+    {
+        PSATDForwardTransformEB(Efield_fp, Bfield_fp, Efield_cp, Bfield_cp);
+        if (WarpX::do_dive_cleaning) { PSATDForwardTransformF(); }
+        if (WarpX::do_divb_cleaning) { PSATDForwardTransformG(); }
+    }
 
     // 2) Set the averaged fields to zero
     if (WarpX::fft_do_time_averaging) { PSATDEraseAverageFields(); }
@@ -731,6 +777,7 @@ WarpX::OneStep_multiJ (const amrex::Real cur_time)
             PSATDBackwardTransformEB(Efield_fp, Bfield_fp, Efield_cp, Bfield_cp);
             if (WarpX::do_dive_cleaning) { PSATDBackwardTransformF(); }
             if (WarpX::do_divb_cleaning) { PSATDBackwardTransformG(); }
+            m_psatd_spectral_fields_current = fft_keep_fields_in_spectral_space;
         }
     }
 
@@ -963,6 +1010,13 @@ WarpX::doFieldIonization ()
 void
 WarpX::doFieldIonization (int lev)
 {
+    if (!ParticlesOnFieldGrids(lev))
+    {
+        auto const& E = Efield_aux_particle_grids[lev];
+        auto const& B = Bfield_aux_particle_grids[lev];
+        mypc->doFieldIonization(lev, *E[0], *E[1], *E[2], *B[0], *B[1], *B[2]);
+        return;
+    }
     mypc->doFieldIonization(lev,
                             *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
                             *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2]);
@@ -980,6 +1034,13 @@ WarpX::doQEDEvents ()
 void
 WarpX::doQEDEvents (int lev)
 {
+    if (!ParticlesOnFieldGrids(lev))
+    {
+        auto const& E = Efield_aux_particle_grids[lev];
+        auto const& B = Bfield_aux_particle_grids[lev];
+        mypc->doQedEvents(lev, *E[0], *E[1], *E[2], *B[0], *B[1], *B[2]);
+        return;
+    }
     mypc->doQedEvents(lev,
                       *Efield_aux[lev][0],*Efield_aux[lev][1],*Efield_aux[lev][2],
                       *Bfield_aux[lev][0],*Bfield_aux[lev][1],*Bfield_aux[lev][2]);
@@ -1024,15 +1085,85 @@ WarpX::PushParticlesandDeposit (int lev, amrex::Real cur_time, DtType a_dt_type,
         current_z = current_fp[lev][2].get();
     }
 
-    mypc->Evolve(lev,
-                 *Efield_aux[lev][0], *Efield_aux[lev][1], *Efield_aux[lev][2],
-                 *Bfield_aux[lev][0], *Bfield_aux[lev][1], *Bfield_aux[lev][2],
-                 *current_x, *current_y, *current_z,
-                 current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
-                 rho_fp[lev].get(), charge_buf[lev].get(),
-                 Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
-                 Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
-                 cur_time, dt[lev], a_dt_type, skip_current, push_type);
+    if (!ParticlesOnFieldGrids(lev))
+    {
+        // The particles have their own distribution mapping (load_balance_particles_only):
+        // gather from the copies of the fields on the particle grids (updated once per step
+        // with the aux fields, see UpdateAuxOnParticleGrids), deposit in temporary
+        // arrays on the particle grids, and send the deposited current and charge back
+        // to the owners of the field boxes, where the guard cells are then summed as usual
+        auto const& E = Efield_aux_particle_grids[lev];
+        auto const& B = Bfield_aux_particle_grids[lev];
+        const std::array<amrex::MultiFab*, 3> current = {current_x, current_y, current_z};
+        const std::array<std::unique_ptr<amrex::MultiFab>, 3> J = {
+            CopyToParticleGrids(lev, *current_x, false),
+            CopyToParticleGrids(lev, *current_y, false),
+            CopyToParticleGrids(lev, *current_z, false)};
+        const std::unique_ptr<amrex::MultiFab> rho =
+            (rho_fp[lev]) ? CopyToParticleGrids(lev, *rho_fp[lev], false) : nullptr;
+
+        mypc->Evolve(lev,
+                     *E[0], *E[1], *E[2],
+                     *B[0], *B[1], *B[2],
+                     *J[0], *J[1], *J[2],
+                     nullptr, nullptr, nullptr,
+                     rho.get(), nullptr,
+                     nullptr, nullptr, nullptr,
+                     nullptr, nullptr, nullptr,
+                     cur_time, dt[lev], a_dt_type, skip_current, push_type);
+
+        if (!skip_current)
+        {
+            for (int idim = 0; idim < 3; ++idim) {
+                current[idim]->Redistribute(*J[idim], 0, 0, J[idim]->nComp(), J[idim]->nGrowVect());
+            }
+            if (rho) { rho_fp[lev]->Redistribute(*rho, 0, 0, rho->nComp(), rho->nGrowVect()); }
+        }
+    }
+    else if (WarpX::do_current_comm_overlap && !skip_current)
+    {
+        // Deposit first with the tiles whose particles may deposit in the cells that are
+        // summed with the other boxes (guard cells, and valid cells within nGrow of the
+        // boundary), start the sum of the guard cells of J, and deposit with the other
+        // tiles while the messages are in flight. The sum is completed in SyncCurrent.
+        amrex::MultiFab const& J = *current_fp[lev][0];
+        amrex::IntVect const tile_margin =
+            get_ng_depos_J() + J.nGrowVect() + amrex::IntVect(1);
+
+        mypc->Evolve(lev,
+                     *Efield_aux[lev][0], *Efield_aux[lev][1], *Efield_aux[lev][2],
+                     *Bfield_aux[lev][0], *Bfield_aux[lev][1], *Bfield_aux[lev][2],
+                     *current_x, *current_y, *current_z,
+                     current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
+                     rho_fp[lev].get(), charge_buf[lev].get(),
+                     Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
+                     Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
+                     cur_time, dt[lev], a_dt_type, skip_current, push_type,
+                     EvolveTiles::Boundary, tile_margin);
+        SumBoundaryJ_nowait(lev);
+        mypc->Evolve(lev,
+                     *Efield_aux[lev][0], *Efield_aux[lev][1], *Efield_aux[lev][2],
+                     *Bfield_aux[lev][0], *Bfield_aux[lev][1], *Bfield_aux[lev][2],
+                     *current_x, *current_y, *current_z,
+                     current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
+                     rho_fp[lev].get(), charge_buf[lev].get(),
+                     Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
+                     Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
+                     cur_time, dt[lev], a_dt_type, skip_current, push_type,
+                     EvolveTiles::Interior, tile_margin);
+    }
+    else
+    {
+        mypc->Evolve(lev,
+                     *Efield_aux[lev][0], *Efield_aux[lev][1], *Efield_aux[lev][2],
+                     *Bfield_aux[lev][0], *Bfield_aux[lev][1], *Bfield_aux[lev][2],
+                     *current_x, *current_y, *current_z,
+                     current_buf[lev][0].get(), current_buf[lev][1].get(), current_buf[lev][2].get(),
+                     rho_fp[lev].get(), charge_buf[lev].get(),
+                     Efield_cax[lev][0].get(), Efield_cax[lev][1].get(), Efield_cax[lev][2].get(),
+                     Bfield_cax[lev][0].get(), Bfield_cax[lev][1].get(), Bfield_cax[lev][2].get(),
+                     cur_time, dt[lev], a_dt_type, skip_current, push_type);
+    }
     if (! skip_current) {
 #ifdef WARPX_DIM_RZ
         // This is called after all particles have deposited their current and charge.
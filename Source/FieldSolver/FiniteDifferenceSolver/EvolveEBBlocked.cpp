@@ -0,0 +1,285 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FiniteDifferenceSolver.H"
+
+#ifndef WARPX_DIM_RZ
+#   include "FiniteDifferenceAlgorithms/CartesianYeeAlgorithm.H"
+#   include "FiniteDifferenceAlgorithms/CartesianCKCAlgorithm.H"
+#   include "FiniteDifferenceAlgorithms/FieldAccessorFunctors.H"
+#endif
+#include "MacroscopicProperties/MacroscopicProperties.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "Utils/WarpXConst.H"
+#include "WarpX.H"
+
+#include <ablastr/coarsen/sample.H>
+
+#include <AMReX.H>
+#include <AMReX_Array4.H>
+#include <AMReX_Box.H>
+#include <AMReX_GpuAtomic.H>
+#include <AMReX_GpuContainers.H>
+#include <AMReX_GpuControl.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IndexType.H>
+#include <AMReX_LayoutData.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Utility.H>
+
+#include <AMReX_BaseFwd.H>
+
+#include <array>
+#include <memory>
+#include <type_traits>
+
+using namespace amrex;
+
+/**
+ * \brief Update the E field over one timestep, and then the B field over a half timestep,
+ * box by box (see warpx.do_fdtd_temporal_blocking)
+ */
+void FiniteDifferenceSolver::EvolveEBBlocked (
+    [[maybe_unused]] std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    [[maybe_unused]] std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    [[maybe_unused]] std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    [[maybe_unused]] std::unique_ptr<MacroscopicProperties> const& macroscopic_properties,
+    [[maybe_unused]] int lev,
+    [[maybe_unused]] amrex::Real const dt_E,
+    [[maybe_unused]] amrex::Real const dt_B ) {
+
+#ifdef WARPX_DIM_RZ
+    WARPX_ABORT_WITH_MESSAGE("EvolveEBBlocked: not implemented in RZ geometry");
+#else
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_grid_type != GridType::Collocated,
+        "EvolveEBBlocked: not implemented on a collocated grid");
+
+    if (WarpX::em_solver_medium == MediumForEM::Vacuum) {
+
+        if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee) {
+            EvolveEBBlockedCartesian <CartesianYeeAlgorithm, void>
+                ( Efield, Bfield, Jfield, macroscopic_properties, lev, dt_E, dt_B );
+        } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
+            EvolveEBBlockedCartesian <CartesianCKCAlgorithm, void>
+                ( Efield, Bfield, Jfield, macroscopic_properties, lev, dt_E, dt_B );
+        } else {
+            WARPX_ABORT_WITH_MESSAGE("EvolveEBBlocked: only implemented for the Yee and CKC solvers");
+        }
+
+    } else if (WarpX::em_solver_medium == MediumForEM::Macroscopic) {
+
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(macroscopic_properties,
+            "EvolveEBBlocked: the macroscopic properties are not initialized");
+        if (m_fdtd_algo == ElectromagneticSolverAlgo::Yee) {
+            if (WarpX::macroscopic_solver_algo == MacroscopicSolverAlgo::LaxWendroff) {
+                EvolveEBBlockedCartesian <CartesianYeeAlgorithm, LaxWendroffAlgo>
+                    ( Efield, Bfield, Jfield, macroscopic_properties, lev, dt_E, dt_B );
+            } else {
+                EvolveEBBlockedCartesian <CartesianYeeAlgorithm, BackwardEulerAlgo>
+                    ( Efield, Bfield, Jfield, macroscopic_properties, lev, dt_E, dt_B );
+            }
+        } else if (m_fdtd_algo == ElectromagneticSolverAlgo::CKC) {
+            if (WarpX::macroscopic_solver_algo == MacroscopicSolverAlgo::LaxWendroff) {
+                EvolveEBBlockedCartesian <CartesianCKCAlgorithm, LaxWendroffAlgo>
+                    ( Efield, Bfield, Jfield, macroscopic_properties, lev, dt_E, dt_B );
+            } else {
+                EvolveEBBlockedCartesian <CartesianCKCAlgorithm, BackwardEulerAlgo>
+                    ( Efield, Bfield, Jfield, macroscopic_properties, lev, dt_E, dt_B );
+            }
+        } else {
+            WARPX_ABORT_WITH_MESSAGE("EvolveEBBlocked: only implemented for the Yee and CKC solvers");
+        }
+
+    } else {
+        WARPX_ABORT_WITH_MESSAGE("EvolveEBBlocked: unknown medium");
+    }
+#endif
+}
+
+
+#ifndef WARPX_DIM_RZ
+
+template<typename T_Algo, typename T_MacroAlgo>
+void FiniteDifferenceSolver::EvolveEBBlockedCartesian (
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Efield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 >& Bfield,
+    std::array< std::unique_ptr<amrex::MultiFab>, 3 > const& Jfield,
+    std::unique_ptr<MacroscopicProperties> const& macroscopic_properties,
+    int lev, amrex::Real const dt_E, amrex::Real const dt_B ) {
+
+    // T_MacroAlgo is void in vacuum, or the scheme of the macroscopic E update
+    constexpr bool macroscopic = !std::is_void_v<T_MacroAlgo>;
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    Real constexpr c2 = PhysConst::c * PhysConst::c;
+
+    // Index types used to interpolate the macroscopic properties to the E locations
+    amrex::GpuArray<int, 3> sigma_stag{}, epsilon_stag{}, macro_cr{};
+    amrex::GpuArray<int, 3> Ex_stag{}, Ey_stag{}, Ez_stag{};
+    if constexpr (macroscopic) {
+        sigma_stag = macroscopic_properties->sigma_IndexType;
+        epsilon_stag = macroscopic_properties->epsilon_IndexType;
+        macro_cr = macroscopic_properties->macro_cr_ratio;
+        Ex_stag = macroscopic_properties->Ex_IndexType;
+        Ey_stag = macroscopic_properties->Ey_IndexType;
+        Ez_stag = macroscopic_properties->Ez_IndexType;
+    }
+
+    // Loop through the grids, without tiling: E is updated in place in one guard cell
+    // around the box, and these cells would be updated twice by neighboring tiles.
+    // The whole box is the block: B reads E right after E was updated, while it is
+    // still in cache for boxes that are small enough.
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+    for ( MFIter mfi(*Efield[0], false); mfi.isValid(); ++mfi ) {
+        if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Extract field data for this grid
+        Array4<Real> const& Ex = Efield[0]->array(mfi);
+        Array4<Real> const& Ey = Efield[1]->array(mfi);
+        Array4<Real> const& Ez = Efield[2]->array(mfi);
+        Array4<Real> const& Bx = Bfield[0]->array(mfi);
+        Array4<Real> const& By = Bfield[1]->array(mfi);
+        Array4<Real> const& Bz = Bfield[2]->array(mfi);
+        Array4<Real const> const& jx = Jfield[0]->const_array(mfi);
+        Array4<Real const> const& jy = Jfield[1]->const_array(mfi);
+        Array4<Real const> const& jz = Jfield[2]->const_array(mfi);
+
+        // Material properties, only used in a macroscopic medium
+        amrex::Array4<amrex::Real> sigma_arr, eps_arr, mu_arr;
+        if constexpr (macroscopic) {
+            sigma_arr = macroscopic_properties->getsigma_mf().array(mfi);
+            eps_arr = macroscopic_properties->getepsilon_mf().array(mfi);
+            mu_arr = macroscopic_properties->getmu_mf().array(mfi);
+        }
+        // Hx = Bx/mu, as in MacroscopicEvolveECartesian
+        FieldAccessorMacroscopic const Hx(Bx, mu_arr);
+        FieldAccessorMacroscopic const Hy(By, mu_arr);
+        FieldAccessorMacroscopic const Hz(Bz, mu_arr);
+
+        // Extract stencil coefficients
+        Real const * const AMREX_RESTRICT coefs_x = m_stencil_coefs_x.dataPtr();
+        auto const n_coefs_x = static_cast<int>(m_stencil_coefs_x.size());
+        Real const * const AMREX_RESTRICT coefs_y = m_stencil_coefs_y.dataPtr();
+        auto const n_coefs_y = static_cast<int>(m_stencil_coefs_y.size());
+        Real const * const AMREX_RESTRICT coefs_z = m_stencil_coefs_z.dataPtr();
+        auto const n_coefs_z = static_cast<int>(m_stencil_coefs_z.size());
+
+        // E is also updated in the first guard cell, where the stencils of the B push
+        // read it, using the guard cells of B and J exchanged beforehand
+        Box const tex = amrex::grow(mfi.tilebox(Efield[0]->ixType().toIntVect()), 1);
+        Box const tey = amrex::grow(mfi.tilebox(Efield[1]->ixType().toIntVect()), 1);
+        Box const tez = amrex::grow(mfi.tilebox(Efield[2]->ixType().toIntVect()), 1);
+        Box const& tbx = mfi.tilebox(Bfield[0]->ixType().toIntVect());
+        Box const& tby = mfi.tilebox(Bfield[1]->ixType().toIntVect());
+        Box const& tbz = mfi.tilebox(Bfield[2]->ixType().toIntVect());
+
+        // The three components are updated by a single kernel over the nodal box that
+        // contains them, i.e. one launch per field instead of three
+        Box const te = amrex::convert(amrex::grow(mfi.validbox(), 1), IntVect::TheNodeVector());
+        Box const tb = amrex::convert(mfi.validbox(), IntVect::TheNodeVector());
+        // starting component to interpolate macro properties to Ex, Ey, Ez locations
+        const int scomp = 0;
+
+        amrex::ParallelFor(te, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            amrex::IntVect const iv(AMREX_D_DECL(i, j, k));
+            if constexpr (!std::is_void_v<T_MacroAlgo>) {
+                if (tex.contains(iv)) {
+                    amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(
+                        sigma_arr, sigma_stag, Ex_stag, macro_cr, i, j, k, scomp);
+                    amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(
+                        eps_arr, epsilon_stag, Ex_stag, macro_cr, i, j, k, scomp);
+                    const amrex::Real alpha = T_MacroAlgo::alpha(sigma_interp, epsilon_interp, dt_E);
+                    const amrex::Real beta = T_MacroAlgo::beta(sigma_interp, epsilon_interp, dt_E);
+                    Ex(i, j, k) = alpha * Ex(i, j, k)
+                                + beta * ( - T_Algo::DownwardDz(Hy, coefs_z, n_coefs_z, i, j, k, 0)
+                                           + T_Algo::DownwardDy(Hz, coefs_y, n_coefs_y, i, j, k, 0)
+                                         ) - beta * jx(i, j, k);
+                }
+                if (tey.contains(iv)) {
+                    amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(
+                        sigma_arr, sigma_stag, Ey_stag, macro_cr, i, j, k, scomp);
+                    amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(
+                        eps_arr, epsilon_stag, Ey_stag, macro_cr, i, j, k, scomp);
+                    const amrex::Real alpha = T_MacroAlgo::alpha(sigma_interp, epsilon_interp, dt_E);
+                    const amrex::Real beta = T_MacroAlgo::beta(sigma_interp, epsilon_interp, dt_E);
+                    Ey(i, j, k) = alpha * Ey(i, j, k)
+                                + beta * ( - T_Algo::DownwardDx(Hz, coefs_x, n_coefs_x, i, j, k, 0)
+                                           + T_Algo::DownwardDz(Hx, coefs_z, n_coefs_z, i, j, k, 0)
+                                         ) - beta * jy(i, j, k);
+                }
+                if (tez.contains(iv)) {
+                    amrex::Real const sigma_interp = ablastr::coarsen::sample::Interp(
+                        sigma_arr, sigma_stag, Ez_stag, macro_cr, i, j, k, scomp);
+                    amrex::Real const epsilon_interp = ablastr::coarsen::sample::Interp(
+                        eps_arr, epsilon_stag, Ez_stag, macro_cr, i, j, k, scomp);
+                    const amrex::Real alpha = T_MacroAlgo::alpha(sigma_interp, epsilon_interp, dt_E);
+                    const amrex::Real beta = T_MacroAlgo::beta(sigma_interp, epsilon_interp, dt_E);
+                    Ez(i, j, k) = alpha * Ez(i, j, k)
+                                + beta * ( - T_Algo::DownwardDy(Hx, coefs_y, n_coefs_y, i, j, k, 0)
+                                           + T_Algo::DownwardDx(Hy, coefs_x, n_coefs_x, i, j, k, 0)
+                                         ) - beta * jz(i, j, k);
+                }
+            } else {
+                if (tex.contains(iv)) {
+                    Ex(i, j, k) += c2 * dt_E * (
+                        - T_Algo::DownwardDz(By, coefs_z, n_coefs_z, i, j, k)
+                        + T_Algo::DownwardDy(Bz, coefs_y, n_coefs_y, i, j, k)
+                        - PhysConst::mu0 * jx(i, j, k) );
+                }
+                if (tey.contains(iv)) {
+                    Ey(i, j, k) += c2 * dt_E * (
+                        - T_Algo::DownwardDx(Bz, coefs_x, n_coefs_x, i, j, k)
+                        + T_Algo::DownwardDz(Bx, coefs_z, n_coefs_z, i, j, k)
+                        - PhysConst::mu0 * jy(i, j, k) );
+                }
+                if (tez.contains(iv)) {
+                    Ez(i, j, k) += c2 * dt_E * (
+                        - T_Algo::DownwardDy(Bx, coefs_y, n_coefs_y, i, j, k)
+                        + T_Algo::DownwardDx(By, coefs_x, n_coefs_x, i, j, k)
+                        - PhysConst::mu0 * jz(i, j, k) );
+                }
+            }
+        });
+
+        amrex::ParallelFor(tb, [=] AMREX_GPU_DEVICE (int i, int j, int k)
+        {
+            amrex::IntVect const iv(AMREX_D_DECL(i, j, k));
+            if (tbx.contains(iv)) {
+                Bx(i, j, k) += dt_B * T_Algo::UpwardDz(Ey, coefs_z, n_coefs_z, i, j, k)
+                             - dt_B * T_Algo::UpwardDy(Ez, coefs_y, n_coefs_y, i, j, k);
+            }
+            if (tby.contains(iv)) {
+                By(i, j, k) += dt_B * T_Algo::UpwardDx(Ez, coefs_x, n_coefs_x, i, j, k)
+                             - dt_B * T_Algo::UpwardDz(Ex, coefs_z, n_coefs_z, i, j, k);
+            }
+            if (tbz.contains(iv)) {
+                Bz(i, j, k) += dt_B * T_Algo::UpwardDy(Ex, coefs_y, n_coefs_y, i, j, k)
+                             - dt_B * T_Algo::UpwardDx(Ey, coefs_x, n_coefs_x, i, j, k);
+            }
+        });
+
+        if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+#endif // corresponds to ifndef WARPX_DIM_RZ
@@ -28,6 +28,85 @@
 
 using namespace amrex::literals;
 
+namespace
+{
+    /**
+     * \brief Compute the coefficients C, S_ck, X1, X2, X3 of the update equations,
+     *        for a given frequency om_s = c*|k| (with the modified k vector)
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void ComputeCoefficients (
+        const amrex::Real om_s, const amrex::Real dt,
+        amrex::Real& C, amrex::Real& S_ck,
+        amrex::Real& X1, amrex::Real& X2, amrex::Real& X3)
+    {
+        // Physical constants
+        constexpr amrex::Real c = PhysConst::c;
+        constexpr amrex::Real ep0 = PhysConst::ep0;
+
+        const amrex::Real c2 = amrex::Math::powi<2>(c);
+        const amrex::Real dt2 = amrex::Math::powi<2>(dt);
+
+        const amrex::Real om2_s = amrex::Math::powi<2>(om_s);
+
+        // C
+        C = std::cos(om_s * dt);
+
+        if (om_s != 0.)
+        {
+            // S_ck
+            S_ck = std::sin(om_s * dt) / om_s;
+            // X1 (multiplies i*([k] \times J) in the update equation for update B)
+            X1 = (1._rt - C) / (ep0 * om2_s);
+            // X2 (multiplies rho_new in the update equation for E)
+            X2 = c2 * (dt - S_ck) / (ep0 * dt * om2_s);
+            // X3 (multiplies rho_old in the update equation for E)
+            X3 = c2 * (dt * C - S_ck) / (ep0 * dt * om2_s);
+        }
+        else // om_s = 0
+        {
+            S_ck = dt;
+            X1 = 0.5_rt * dt2 / ep0;
+            X2 = c2 * dt2 / (6._rt * ep0);
+            X3 = - c2 * dt2 / (3._rt * ep0);
+        }
+    }
+
+    /**
+     * \brief Compute the coefficients X5, X6 of the time-averaged update equations,
+     *        for a given frequency om_s = c*|k| and the coefficients C and S_ck
+     */
+    AMREX_GPU_HOST_DEVICE AMREX_FORCE_INLINE
+    void ComputeCoefficientsAveraging (
+        const amrex::Real om_s, const amrex::Real dt,
+        const amrex::Real C, const amrex::Real S_ck,
+        amrex::Real& X5, amrex::Real& X6)
+    {
+        // Physical constants
+        constexpr amrex::Real c = PhysConst::c;
+        constexpr amrex::Real c2 = c*c;
+        constexpr amrex::Real ep0 = PhysConst::ep0;
+
+        // Auxiliary coefficients
+        const amrex::Real dt3 = dt * dt * dt;
+
+        const amrex::Real om2_s = om_s * om_s;
+        const amrex::Real om4_s = om2_s * om2_s;
+
+        if (om_s != 0.)
+        {
+            X5 = c2 / ep0 * (S_ck / om2_s - (1._rt - C) / (om4_s * dt)
+                             - 0.5_rt * dt / om2_s);
+            X6 = c2 / ep0 * ((1._rt - C) / (om4_s * dt) - 0.5_rt * dt / om2_s);
+        }
+        else
+        {
+            X5 = - c2 * dt3 / (8._rt * ep0);
+            X6 = - c2 * dt3 / (24._rt * ep0);
+        }
+    }
+}
+
 PsatdAlgorithmJLinearInTime::PsatdAlgorithmJLinearInTime(
     const SpectralKSpace& spectral_kspace,
     const amrex::DistributionMapping& dm,
@@ -39,16 +118,30 @@ PsatdAlgorithmJLinearInTime::PsatdAlgorithmJLinearInTime(
     const amrex::Real dt,
     const bool time_averaging,
     const bool dive_cleaning,
-    const bool divb_cleaning)
+    const bool divb_cleaning,
+    const bool on_the_fly_coefficients)
     // Initializer list
     : SpectralBaseAlgorithm(spectral_kspace, dm, spectral_index, norder_x, norder_y, norder_z, grid_type),
     m_dt(dt),
     m_time_averaging(time_averaging),
     m_dive_cleaning(dive_cleaning),
-    m_divb_cleaning(divb_cleaning)
+    m_divb_cleaning(divb_cleaning),
+    m_on_the_fly_coefficients(on_the_fly_coefficients)
 {
     const amrex::BoxArray& ba = spectral_kspace.spectralspace_ba;
 
+    // Number of real coefficients per point in spectral space
+    const int ncoefs = (time_averaging) ? 7 : 5;
+
+    // Memory used (or saved) by the coefficients on this MPI rank
+    for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
+    {
+        m_coef_bytes += ba[mfi].numPts() * ncoefs * static_cast<amrex::Long>(sizeof(amrex::Real));
+    }
+
+    // The coefficients are evaluated in pushSpectralFields
+    if (on_the_fly_coefficients) { return; }
+
     // Always allocate these coefficients
     C_coef = SpectralRealCoefficients(ba, dm, 1, 0);
     S_ck_coef = SpectralRealCoefficients(ba, dm, 1, 0);
@@ -73,6 +166,7 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
     const bool time_averaging = m_time_averaging;
     const bool dive_cleaning = m_dive_cleaning;
     const bool divb_cleaning = m_divb_cleaning;
+    const bool on_the_fly_coefficients = m_on_the_fly_coefficients;
 
     const amrex::Real dt = m_dt;
 
@@ -86,16 +180,24 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
         // Extract arrays for the fields to be updated
         const amrex::Array4<Complex> fields = f.fields[mfi].array();
 
-        // These coefficients are always allocated
-        const amrex::Array4<const amrex::Real> C_arr = C_coef[mfi].array();
-        const amrex::Array4<const amrex::Real> S_ck_arr = S_ck_coef[mfi].array();
-        const amrex::Array4<const amrex::Real> X1_arr = X1_coef[mfi].array();
-        const amrex::Array4<const amrex::Real> X2_arr = X2_coef[mfi].array();
-        const amrex::Array4<const amrex::Real> X3_arr = X3_coef[mfi].array();
+        // These coefficients are allocated unless they are computed on the fly
+        amrex::Array4<const amrex::Real> C_arr;
+        amrex::Array4<const amrex::Real> S_ck_arr;
+        amrex::Array4<const amrex::Real> X1_arr;
+        amrex::Array4<const amrex::Real> X2_arr;
+        amrex::Array4<const amrex::Real> X3_arr;
+        if (!on_the_fly_coefficients)
+        {
+            C_arr = C_coef[mfi].array();
+            S_ck_arr = S_ck_coef[mfi].array();
+            X1_arr = X1_coef[mfi].array();
+            X2_arr = X2_coef[mfi].array();
+            X3_arr = X3_coef[mfi].array();
+        }
 
         amrex::Array4<const amrex::Real> X5_arr;
         amrex::Array4<const amrex::Real> X6_arr;
-        if (time_averaging)
+        if (time_averaging && !on_the_fly_coefficients)
         {
             X5_arr = X5_coef[mfi].array();
             X6_arr = X6_coef[mfi].array();
@@ -148,12 +250,23 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
             constexpr amrex::Real inv_ep0 = 1._rt / PhysConst::ep0;
             constexpr Complex I = Complex{0._rt, 1._rt};
 
-            // These coefficients are initialized in the function InitializeSpectralCoefficients
-            const amrex::Real C = C_arr(i,j,k);
-            const amrex::Real S_ck = S_ck_arr(i,j,k);
-            const amrex::Real X1 = X1_arr(i,j,k);
-            const amrex::Real X2 = X2_arr(i,j,k);
-            const amrex::Real X3 = X3_arr(i,j,k);
+            // These coefficients are initialized in the function InitializeSpectralCoefficients,
+            // or computed here from the modified k vector
+            amrex::Real C, S_ck, X1, X2, X3;
+            amrex::Real om_s = 0._rt;
+            if (on_the_fly_coefficients)
+            {
+                om_s = PhysConst::c * std::sqrt(kx*kx + ky*ky + kz*kz);
+                ComputeCoefficients(om_s, dt, C, S_ck, X1, X2, X3);
+            }
+            else
+            {
+                C = C_arr(i,j,k);
+                S_ck = S_ck_arr(i,j,k);
+                X1 = X1_arr(i,j,k);
+                X2 = X2_arr(i,j,k);
+                X3 = X3_arr(i,j,k);
+            }
             const amrex::Real X4 = - S_ck / PhysConst::ep0;
 
             // Update equations for E in the formulation with rho
@@ -211,8 +324,16 @@ PsatdAlgorithmJLinearInTime::pushSpectralFields (SpectralFieldData& f) const
 
             if (time_averaging)
             {
-                const amrex::Real X5 = X5_arr(i,j,k);
-                const amrex::Real X6 = X6_arr(i,j,k);
+                amrex::Real X5, X6;
+                if (on_the_fly_coefficients)
+                {
+                    ComputeCoefficientsAveraging(om_s, dt, C, S_ck, X5, X6);
+                }
+                else
+                {
+                    X5 = X5_arr(i,j,k);
+                    X6 = X6_arr(i,j,k);
+                }
 
                 // TODO: Here the code is *accumulating* the average,
                 // because it is meant to be used with sub-cycling
@@ -297,58 +418,9 @@ void PsatdAlgorithmJLinearInTime::InitializeSpectralCoefficients (
 #else
                 amrex::Math::powi<2>(kz_s[j]));
 #endif
-            // Physical constants and imaginary unit
-            constexpr amrex::Real c = PhysConst::c;
-            constexpr amrex::Real ep0 = PhysConst::ep0;
-
-            const amrex::Real c2 = amrex::Math::powi<2>(c);
-            const amrex::Real dt2 = amrex::Math::powi<2>(dt);
-
-            const amrex::Real om_s = c * knorm_s;
-            const amrex::Real om2_s = amrex::Math::powi<2>(om_s);
-
-            // C
-            C(i,j,k) = std::cos(om_s * dt);
-
-            // S_ck
-            if (om_s != 0.)
-            {
-                S_ck(i,j,k) = std::sin(om_s * dt) / om_s;
-            }
-            else // om_s = 0
-            {
-                S_ck(i,j,k) = dt;
-            }
+            const amrex::Real om_s = PhysConst::c * knorm_s;
 
-            // X1 (multiplies i*([k] \times J) in the update equation for update B)
-            if (om_s != 0.)
-            {
-                X1(i,j,k) = (1._rt - C(i,j,k)) / (ep0 * om2_s);
-            }
-            else // om_s = 0
-            {
-                X1(i,j,k) = 0.5_rt * dt2 / ep0;
-            }
-
-            // X2 (multiplies rho_new in the update equation for E)
-            if (om_s != 0.)
-            {
-                X2(i,j,k) = c2 * (dt - S_ck(i,j,k)) / (ep0 * dt * om2_s);
-            }
-            else // om_s = 0
-            {
-                X2(i,j,k) = c2 * dt2 / (6._rt * ep0);
-            }
-
-            // X3 (multiplies rho_old in the update equation for E)
-            if (om_s != 0.)
-            {
-                X3(i,j,k) = c2 * (dt * C(i,j,k) - S_ck(i,j,k)) / (ep0 * dt * om2_s);
-            }
-            else // om_s = 0
-            {
-                X3(i,j,k) = - c2 * dt2 / (3._rt * ep0);
-            }
+            ComputeCoefficients(om_s, dt, C(i,j,k), S_ck(i,j,k), X1(i,j,k), X2(i,j,k), X3(i,j,k));
         });
     }
 }
@@ -389,36 +461,9 @@ void PsatdAlgorithmJLinearInTime::InitializeSpectralCoefficientsAveraging (
 #else
                 amrex::Math::powi<2>(kz_s[j]));
 #endif
-            // Physical constants and imaginary unit
-            constexpr amrex::Real c = PhysConst::c;
-            constexpr amrex::Real c2 = c*c;
-            constexpr amrex::Real ep0 = PhysConst::ep0;
-
-            // Auxiliary coefficients
-            const amrex::Real dt3 = dt * dt * dt;
+            const amrex::Real om_s = PhysConst::c * knorm_s;
 
-            const amrex::Real om_s  = c * knorm_s;
-            const amrex::Real om2_s = om_s * om_s;
-            const amrex::Real om4_s = om2_s * om2_s;
-
-            if (om_s != 0.)
-            {
-                X5(i,j,k) = c2 / ep0 * (S_ck(i,j,k) / om2_s - (1._rt - C(i,j,k)) / (om4_s * dt)
-                                        - 0.5_rt * dt / om2_s);
-            }
-            else
-            {
-                X5(i,j,k) = - c2 * dt3 / (8._rt * ep0);
-            }
-
-            if (om_s != 0.)
-            {
-                X6(i,j,k) = c2 / ep0 * ((1._rt - C(i,j,k)) / (om4_s * dt) - 0.5_rt * dt / om2_s);
-            }
-            else
-            {
-                X6(i,j,k) = - c2 * dt3 / (24._rt * ep0);
-            }
+            ComputeCoefficientsAveraging(om_s, dt, C(i,j,k), S_ck(i,j,k), X5(i,j,k), X6(i,j,k));
         });
     }
 }
@@ -29,6 +29,8 @@
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 
+#include <complex>
+
 #if WARPX_USE_FFT
 
 using namespace amrex;
@@ -122,9 +124,16 @@ SpectralFieldData::SpectralFieldData( const int lev,
                                       const SpectralKSpace& k_space,
                                       const amrex::DistributionMapping& dm,
                                       const int n_field_required,
-                                      const bool periodic_single_box):
-    m_periodic_single_box{periodic_single_box}
+                                      const bool periodic_single_box,
+                                      const bool distributed_fft):
+    m_periodic_single_box{periodic_single_box},
+    m_distributed_fft{distributed_fft}
 {
+#ifndef WARPX_USE_HEFFTE
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!distributed_fft,
+        "Distributed FFTs require WarpX to be compiled with heFFTe (WarpX_HEFFTE=ON)");
+#endif
+
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, realspace_ba, dm);
 
@@ -136,8 +145,13 @@ SpectralFieldData::SpectralFieldData( const int lev,
 
     // Allocate temporary arrays - in real space and spectral space
     // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // (three components, to transform the components of a vector field in one batch)
+    // With distributed FFTs, the temporary array in real space is allocated with
+    // the index type of each transformed field
+    if (!m_distributed_fft) {
+        tmpRealField = MultiFab(realspace_ba, dm, 3, 0);
+    }
+    tmpSpectralField = SpectralField(spectralspace_ba, dm, (m_distributed_fft) ? 1 : 3, 0);
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // If the FFT is performed from/to a cell-centered grid in real space,
@@ -159,9 +173,41 @@ SpectralFieldData::SpectralFieldData( const int lev,
 #endif
 #endif
 
+#ifdef WARPX_USE_HEFFTE
+    // Initialize the plan of the distributed FFT, from the box of the whole domain
+    // owned by the local MPI rank, in real space and in spectral space
+    if (m_distributed_fft)
+    {
+        m_realspace_fft_ba = k_space.realspace_fft_ba;
+        const IntVect domain_lo = m_realspace_fft_ba.minimalBox().smallEnd();
+        const int rank = amrex::ParallelDescriptor::MyProc();
+        const Box real_bx = m_realspace_fft_ba[rank];
+        const Box spectral_bx = spectralspace_ba[rank];
+
+        std::array<int,3> real_lo = {0, 0, 0}, real_hi = {0, 0, 0};
+        std::array<int,3> spectral_lo = {0, 0, 0}, spectral_hi = {0, 0, 0};
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            real_lo[idim] = real_bx.smallEnd(idim) - domain_lo[idim];
+            real_hi[idim] = real_bx.bigEnd(idim) - domain_lo[idim];
+            spectral_lo[idim] = spectral_bx.smallEnd(idim);
+            spectral_hi[idim] = spectral_bx.bigEnd(idim);
+        }
+
+        heffte::plan_options options = heffte::default_options<heffte_backend>();
+        options.use_pencils = true;
+
+        m_distributed_plan = std::make_unique<heffte::fft3d_r2c<heffte_backend>>(
+            heffte::box3d<>(real_lo, real_hi), heffte::box3d<>(spectral_lo, spectral_hi),
+            0, amrex::ParallelDescriptor::Communicator(), options);
+        return;
+    }
+#endif
+
     // Allocate and initialize the FFT plans
     forward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
     backward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+    forward_plan_batch = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+    backward_plan_batch = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
     // Loop over boxes and allocate the corresponding plan
     // for each box owned by the local MPI proc
     for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
@@ -186,6 +232,16 @@ SpectralFieldData::SpectralFieldData( const int lev,
             reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
             ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
 
+        forward_plan_batch[mfi] = ablastr::math::anyfft::CreatePlan(
+            fft_size, tmpRealField[mfi].dataPtr(),
+            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+            ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM, 3);
+
+        backward_plan_batch[mfi] = ablastr::math::anyfft::CreatePlan(
+            fft_size, tmpRealField[mfi].dataPtr(),
+            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+            ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM, 3);
+
         if (do_costs)
         {
             amrex::Gpu::synchronize();
@@ -202,6 +258,8 @@ SpectralFieldData::~SpectralFieldData()
         for ( MFIter mfi(tmpRealField); mfi.isValid(); ++mfi ){
             ablastr::math::anyfft::DestroyPlan(forward_plan[mfi]);
             ablastr::math::anyfft::DestroyPlan(backward_plan[mfi]);
+            ablastr::math::anyfft::DestroyPlan(forward_plan_batch[mfi]);
+            ablastr::math::anyfft::DestroyPlan(backward_plan_batch[mfi]);
         }
     }
 }
@@ -214,6 +272,13 @@ SpectralFieldData::ForwardTransform (const int lev,
                                      const MultiFab& mf, const int field_index,
                                      const int i_comp)
 {
+#ifdef WARPX_USE_HEFFTE
+    if (m_distributed_fft) {
+        ForwardTransformDistributed(mf, field_index, i_comp);
+        return;
+    }
+#endif
+
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
 
@@ -314,6 +379,13 @@ SpectralFieldData::BackwardTransform (const int lev,
                                       const amrex::IntVect& fill_guards,
                                       const int i_comp)
 {
+#ifdef WARPX_USE_HEFFTE
+    if (m_distributed_fft) {
+        BackwardTransformDistributed(lev, mf, field_index, i_comp);
+        return;
+    }
+#endif
+
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
 
@@ -428,4 +500,401 @@ SpectralFieldData::BackwardTransform (const int lev,
     }
 }
 
+/* \brief Transform the three MultiFabs `mf` to spectral space, in one batch of FFTs,
+ *  and store the corresponding results internally (in the spectral fields specified
+ *  by `field_index`). The copies to the temporary field and the shifts in spectral
+ *  space are done by one kernel for the three fields. */
+void
+SpectralFieldData::ForwardTransform (const int lev,
+                                     const std::array<const amrex::MultiFab*, 3>& mf,
+                                     const std::array<int, 3>& field_index)
+{
+#ifdef WARPX_USE_HEFFTE
+    if (m_distributed_fft) {
+        for (int n = 0; n < 3; ++n) { ForwardTransformDistributed(*mf[n], field_index[n], 0); }
+        return;
+    }
+#endif
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf[0]->boxArray(), mf[0]->DistributionMap());
+
+    // Check field index types, in order to apply proper shift in spectral space
+    amrex::GpuArray<amrex::IntVect, 3> is_nodal;
+    amrex::GpuArray<int, 3> dst_comp;
+    for (int n = 0; n < 3; ++n) {
+        is_nodal[n] = mf[n]->ixType().toIntVect();
+        dst_comp[n] = field_index[n];
+    }
+
+    // Loop over boxes
+    // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
+    //       the FFTs on each box!
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Copy the real-space fields `mf` to the components of `tmpRealField`
+        // (discarding the last point along the nodal directions, as for one field)
+        {
+            amrex::GpuArray<Array4<const Real>, 3> mf_arr;
+            for (int n = 0; n < 3; ++n) {
+                Box realspace_bx = (m_periodic_single_box) ? mf[n]->box(mfi.index()) // Discard guard cells
+                                                           : (*mf[n])[mfi].box(); // Keep guard cells
+                realspace_bx.enclosedCells(); // Discard last point in nodal direction
+                AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmpRealField[mfi].box()) );
+                mf_arr[n] = mf[n]->const_array(mfi);
+            }
+            const Array4<Real> tmp_arr = tmpRealField[mfi].array();
+            ParallelFor( tmpRealField[mfi].box(), 3,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                tmp_arr(i,j,k,n) = mf_arr[n](i,j,k);
+            });
+        }
+
+        // Perform the batch of Fourier transforms from `tmpRealField` to `tmpSpectralField`
+        ablastr::math::anyfft::Execute(forward_plan_batch[mfi]);
+
+        // Copy the components of `tmpSpectralField` to the appropriate indices
+        // of the FabArray `fields` and apply the correcting shift factors
+        {
+            const Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
+            const Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
+
+            const Complex* shift0_arr = shift0_FFTfromCell[mfi].dataPtr();
+#if AMREX_SPACEDIM > 1
+            const Complex* shift1_arr = shift1_FFTfromCell[mfi].dataPtr();
+#if AMREX_SPACEDIM > 2
+            const Complex* shift2_arr = shift2_FFTfromCell[mfi].dataPtr();
+#endif
+#endif
+            // Loop over indices within one box
+            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+            ParallelFor( spectralspace_bx, 3,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = tmp_arr(i,j,k,n);
+                // Apply proper shift in each dimension
+                if (!is_nodal[n][0]) { spectral_field_value *= shift0_arr[i]; }
+#if AMREX_SPACEDIM > 1
+                if (!is_nodal[n][1]) { spectral_field_value *= shift1_arr[j]; }
+#if AMREX_SPACEDIM > 2
+                if (!is_nodal[n][2]) { spectral_field_value *= shift2_arr[k]; }
+#endif
+#endif
+                // Copy field into the right index
+                fields_arr(i,j,k,dst_comp[n]) = spectral_field_value;
+            });
+        }
+
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+
+/* \brief Transform the three spectral fields specified by `field_index` back to
+ * real space, in one batch of FFTs, and store them in the MultiFabs `mf` */
+void
+SpectralFieldData::BackwardTransform (const int lev,
+                                      const std::array<amrex::MultiFab*, 3>& mf,
+                                      const std::array<int, 3>& field_index,
+                                      const amrex::IntVect& fill_guards)
+{
+#ifdef WARPX_USE_HEFFTE
+    if (m_distributed_fft) {
+        for (int n = 0; n < 3; ++n) { BackwardTransformDistributed(lev, *mf[n], field_index[n], 0); }
+        return;
+    }
+#endif
+
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf[0]->boxArray(), mf[0]->DistributionMap());
+
+    // Check field index types, in order to apply proper shift in spectral space
+    amrex::GpuArray<amrex::IntVect, 3> is_nodal;
+    amrex::GpuArray<int, 3> src_comp;
+    for (int n = 0; n < 3; ++n) {
+        is_nodal[n] = mf[n]->ixType().toIntVect();
+        src_comp[n] = field_index[n];
+    }
+
+    // Loop over boxes
+    // Note: we do NOT OpenMP parallelize here, since we use OpenMP threads for
+    //       the iFFTs on each box!
+    for ( MFIter mfi(*mf[0]); mfi.isValid(); ++mfi ){
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+        }
+        auto wt = static_cast<amrex::Real>(amrex::second());
+
+        // Copy the spectral fields to the components of `tmpSpectralField`
+        // and apply the correcting shift factors
+        {
+            const Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
+            const Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+            const Complex* shift0_arr = shift0_FFTtoCell[mfi].dataPtr();
+#if AMREX_SPACEDIM > 1
+            const Complex* shift1_arr = shift1_FFTtoCell[mfi].dataPtr();
+#if AMREX_SPACEDIM > 2
+            const Complex* shift2_arr = shift2_FFTtoCell[mfi].dataPtr();
+#endif
+#endif
+            // Loop over indices within one box
+            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+
+            ParallelFor( spectralspace_bx, 3,
+            [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept {
+                Complex spectral_field_value = field_arr(i,j,k,src_comp[n]);
+                // Apply proper shift in each dimension
+                if (!is_nodal[n][0]) { spectral_field_value *= shift0_arr[i]; }
+#if AMREX_SPACEDIM > 1
+                if (!is_nodal[n][1]) { spectral_field_value *= shift1_arr[j]; }
+#if AMREX_SPACEDIM > 2
+                if (!is_nodal[n][2]) { spectral_field_value *= shift2_arr[k]; }
+#endif
+#endif
+                // Copy field into temporary array
+                tmp_arr(i,j,k,n) = spectral_field_value;
+            });
+        }
+
+        // Perform the batch of Fourier transforms from `tmpSpectralField` to `tmpRealField`
+        ablastr::math::anyfft::Execute(backward_plan_batch[mfi]);
+
+        // Copy the components of tmpRealField to the real-space fields mf and normalize
+        // (see the transform of one field for the treatment of the nodal directions)
+        {
+            amrex::GpuArray<amrex::Array4<amrex::Real>, 3> mf_arr;
+            amrex::GpuArray<amrex::Box, 3> mf_box;
+            amrex::GpuArray<amrex::Dim3, 3> lo;
+            amrex::GpuArray<amrex::Dim3, 3> wrap;
+            amrex::Box union_box;
+            for (int n = 0; n < 3; ++n) {
+                mf_arr[n] = mf[n]->array(mfi);
+                mf_box[n] = (m_periodic_single_box) ? mf[n]->box(mfi.index()) : (*mf[n])[mfi].box();
+
+                // Index of the last outer guard cell along the nodal directions,
+                // set equal to the first one
+                const amrex::Dim3 lo_n = amrex::lbound(mf_box[n]);
+                const auto len = mf_box[n].length3d();
+                const amrex::IntVect s = is_nodal[n];
+                lo[n] = lo_n;
+                wrap[n] = amrex::Dim3{lo_n.x + len[0] - s[0],
+                                      (AMREX_SPACEDIM > 1) ? lo_n.y + len[1] - s[1] : 1,
+                                      (AMREX_SPACEDIM > 2) ? lo_n.z + len[2] - s[2] : 1};
+
+                // If necessary, do not fill the guard cells
+                // (shrink box by passing negative number of cells)
+                if (!m_periodic_single_box)
+                {
+                    const amrex::IntVect& mf_ng = mf[n]->nGrowVect();
+                    for (int dir = 0; dir < AMREX_SPACEDIM; dir++)
+                    {
+                        if ((fill_guards[dir]) == 0) { mf_box[n].grow(dir, -mf_ng[dir]); }
+                    }
+                }
+
+                // Boxes of different index types, converted to nodal to compute their union
+                const amrex::Box nodal_box = amrex::convert(mf_box[n], amrex::IntVect::TheNodeVector());
+                union_box = (n == 0) ? nodal_box : union_box.minBox(nodal_box);
+            }
+            const amrex::Array4<const amrex::Real> tmp_arr = tmpRealField[mfi].array();
+
+            const amrex::Real inv_N = 1._rt / tmpRealField[mfi].box().numPts();
+
+            ParallelFor(union_box, 3, [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept
+            {
+                if (!mf_box[n].contains(amrex::IntVect(AMREX_D_DECL(i,j,k)))) { return; }
+                const int ii = (i == wrap[n].x) ? lo[n].x : i;
+                const int jj = (j == wrap[n].y) ? lo[n].y : j;
+                const int kk = (k == wrap[n].z) ? lo[n].z : k;
+                // Copy and normalize field
+                mf_arr[n](i,j,k) = inv_N * tmp_arr(ii,jj,kk,n);
+            });
+        }
+
+        if (do_costs)
+        {
+            amrex::Gpu::synchronize();
+            wt = static_cast<amrex::Real>(amrex::second()) - wt;
+            amrex::HostDevice::Atomic::Add( &(*cost)[mfi.index()], wt);
+        }
+    }
+}
+
+#ifdef WARPX_USE_HEFFTE
+namespace
+{
+    /* \brief Return a BoxArray with the same indices as `ba` (i.e. the same number of points)
+     *  but with the index type `ixtype`. For a decomposition of a periodic domain, this
+     *  excludes the last point along the nodal directions (periodic image of the first one). */
+    amrex::BoxArray ConvertKeepingSize (const amrex::BoxArray& ba, const amrex::IndexType ixtype)
+    {
+        amrex::BoxList bl(ixtype);
+        for (int i = 0; i < ba.size(); ++i) {
+            bl.push_back(amrex::Box(ba[i].smallEnd(), ba[i].bigEnd(), ixtype));
+        }
+        return amrex::BoxArray(bl);
+    }
+}
+
+SpectralFieldData::DistributedFFTBuffer&
+SpectralFieldData::GetDistributedFFTBuffer (const amrex::MultiFab& mf)
+{
+    DistributedFFTBuffer& buffer = m_distributed_fft_buffers[mf.ixType()];
+    if (!buffer.tmp_real.ok()) {
+        // One box per MPI rank, as expected by the distributed FFT
+        buffer.tmp_real.define(ConvertKeepingSize(m_realspace_fft_ba, mf.ixType()),
+                               fields.DistributionMap(), 1, 0);
+    }
+    if (buffer.mf_ba != mf.boxArray() || buffer.mf_dm != mf.DistributionMap()) {
+        buffer.mf_ba = mf.boxArray();
+        buffer.mf_dm = mf.DistributionMap();
+        buffer.copy_from_mf.reset();
+        buffer.copy_to_mf.reset();
+    }
+    return buffer;
+}
+
+/* \brief Transform the component `i_comp` of MultiFab `mf` to spectral space with the
+ *  distributed FFT over the whole domain, and store the corresponding result internally
+ *  (in the spectral field specified by `field_index`) */
+void
+SpectralFieldData::ForwardTransformDistributed (const amrex::MultiFab& mf,
+                                                const int field_index,
+                                                const int i_comp)
+{
+    // Check field index type, in order to apply proper shift in spectral space
+    const amrex::IntVect is_nodal = mf.ixType().toIntVect();
+
+    // Copy the real-space field `mf` to one box per MPI rank, as expected by the
+    // distributed FFT. This discards the *last* point of `mf` in any direction
+    // that has *nodal* index type (periodic image of the first point).
+    DistributedFFTBuffer& buffer = GetDistributedFFTBuffer(mf);
+    amrex::MultiFab& tmp_real = buffer.tmp_real;
+    if (!buffer.copy_from_mf) {
+        buffer.copy_from_mf = std::make_unique<amrex::FabArrayBase::CPC>(
+            tmp_real, amrex::IntVect(0), mf, amrex::IntVect(0), amrex::Periodicity::NonPeriodic());
+    }
+    tmp_real.ParallelCopy(mf, i_comp, 0, 1, amrex::IntVect(0), amrex::IntVect(0),
+                          amrex::Periodicity::NonPeriodic(), amrex::FabArrayBase::COPY,
+                          buffer.copy_from_mf.get());
+
+    // Exactly one box per MPI rank, in real space and in spectral space
+    for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+
+        // Perform the distributed Fourier transform from `tmp_real` to `tmpSpectralField`
+        amrex::Gpu::streamSynchronize();
+        m_distributed_plan->forward(tmp_real[mfi].dataPtr(),
+            reinterpret_cast<std::complex<amrex::Real>*>(tmpSpectralField[mfi].dataPtr()));
+        amrex::Gpu::synchronize();
+
+        // Copy the spectral-space field `tmpSpectralField` to the appropriate
+        // index of the FabArray `fields` (specified by `field_index`)
+        // and apply correcting shift factor if the real space data comes
+        // from a cell-centered grid in real space instead of a nodal grid.
+        const Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
+        const Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
+
+        const Complex* shift0_arr = shift0_FFTfromCell[mfi].dataPtr();
+#if AMREX_SPACEDIM > 1
+        const Complex* shift1_arr = shift1_FFTfromCell[mfi].dataPtr();
+#if AMREX_SPACEDIM > 2
+        const Complex* shift2_arr = shift2_FFTfromCell[mfi].dataPtr();
+#endif
+#endif
+        ParallelFor( tmpSpectralField[mfi].box(),
+        [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            Complex spectral_field_value = tmp_arr(i,j,k);
+            // Apply proper shift in each dimension
+            if (!is_nodal[0]) { spectral_field_value *= shift0_arr[i]; }
+#if AMREX_SPACEDIM > 1
+            if (!is_nodal[1]) { spectral_field_value *= shift1_arr[j]; }
+#if AMREX_SPACEDIM > 2
+            if (!is_nodal[2]) { spectral_field_value *= shift2_arr[k]; }
+#endif
+#endif
+            // Copy field into the right index
+            fields_arr(i,j,k,field_index) = spectral_field_value;
+        });
+    }
+}
+
+/* \brief Transform spectral field specified by `field_index` back to real space with
+ *  the distributed FFT over the whole domain, and store it in the component `i_comp`
+ *  of `mf` (valid points only, the guard cells are filled by FillBoundary) */
+void
+SpectralFieldData::BackwardTransformDistributed (const int lev,
+                                                 amrex::MultiFab& mf,
+                                                 const int field_index,
+                                                 const int i_comp)
+{
+    // Check field index type, in order to apply proper shift in spectral space
+    const amrex::IntVect is_nodal = mf.ixType().toIntVect();
+
+    // Temporary field in real space, with one box per MPI rank
+    DistributedFFTBuffer& buffer = GetDistributedFFTBuffer(mf);
+    amrex::MultiFab& tmp_real = buffer.tmp_real;
+
+    // Exactly one box per MPI rank, in real space and in spectral space
+    for ( MFIter mfi(tmpSpectralField); mfi.isValid(); ++mfi ){
+
+        // Copy the spectral-space field to the temporary field `tmpSpectralField`
+        // and apply correcting shift factor if the real space data is
+        // on a cell-centered grid in real space instead of a nodal grid.
+        const Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
+        const Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+
+        const Complex* shift0_arr = shift0_FFTtoCell[mfi].dataPtr();
+#if AMREX_SPACEDIM > 1
+        const Complex* shift1_arr = shift1_FFTtoCell[mfi].dataPtr();
+#if AMREX_SPACEDIM > 2
+        const Complex* shift2_arr = shift2_FFTtoCell[mfi].dataPtr();
+#endif
+#endif
+        ParallelFor( tmpSpectralField[mfi].box(),
+        [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            Complex spectral_field_value = field_arr(i,j,k,field_index);
+            // Apply proper shift in each dimension
+            if (!is_nodal[0]) { spectral_field_value *= shift0_arr[i]; }
+#if AMREX_SPACEDIM > 1
+            if (!is_nodal[1]) { spectral_field_value *= shift1_arr[j]; }
+#if AMREX_SPACEDIM > 2
+            if (!is_nodal[2]) { spectral_field_value *= shift2_arr[k]; }
+#endif
+#endif
+            // Copy field into temporary array
+            tmp_arr(i,j,k) = spectral_field_value;
+        });
+
+        // Perform the distributed Fourier transform from `tmpSpectralField` to `tmp_real`,
+        // normalized by the number of points of the domain
+        amrex::Gpu::streamSynchronize();
+        m_distributed_plan->backward(
+            reinterpret_cast<std::complex<amrex::Real>*>(tmpSpectralField[mfi].dataPtr()),
+            tmp_real[mfi].dataPtr(), heffte::scale::full);
+        amrex::Gpu::synchronize();
+    }
+
+    // Copy the result to the boxes of `mf`: the last point along the nodal
+    // directions is filled with the periodic image of the first point
+    const amrex::Periodicity& period = WarpX::GetInstance().Geom(lev).periodicity();
+    if (!buffer.copy_to_mf) {
+        buffer.copy_to_mf = std::make_unique<amrex::FabArrayBase::CPC>(
+            mf, amrex::IntVect(0), tmp_real, amrex::IntVect(0), period);
+    }
+    mf.ParallelCopy(tmp_real, 0, i_comp, 1, amrex::IntVect(0), amrex::IntVect(0),
+                    period, amrex::FabArrayBase::COPY, buffer.copy_to_mf.get());
+}
+#endif
+
 #endif // WARPX_USE_FFT
@@ -236,11 +236,14 @@ SpectralFieldDataRZ::~SpectralFieldDataRZ()
  *  The input, tempHTransformedSplit, is the complex, Hankel transformed
  *  data, which is stored wih the real and imaginary parts split.
  *  The input should include the imaginary component of mode 0
- *  (even though it is all zeros). */
+ *  (even though it is all zeros).
+ *  If `apply_filter` is true, the k-space filter is applied when
+ *  copying the result into `fields`, instead of in a separate pass. */
 void
 SpectralFieldDataRZ::FABZForwardTransform (amrex::MFIter const & mfi, amrex::Box const & realspace_bx,
                                            amrex::MultiFab const & tempHTransformedSplit,
-                                           int const field_index, const bool is_nodal_z)
+                                           int const field_index, const bool is_nodal_z,
+                                           const bool apply_filter)
 {
     // Copy the split complex to the interleaved complex.
 
@@ -323,15 +326,25 @@ SpectralFieldDataRZ::FABZForwardTransform (amrex::MFIter const & mfi, amrex::Box
     // The fields are organized so that the fields for each mode
     // are grouped together in memory.
     amrex::Box const& spectralspace_bx = tmpSpectralField[mfi].box();
+    int const nr = spectralspace_bx.length(0);
     int const nz = spectralspace_bx.length(1);
     const amrex::Real inv_nz = 1._rt/nz;
     const int n_fields = m_n_fields;
 
+    // The filter arrays are only defined when the k-space filter is used
+    amrex::Real const* filter_r_arr = apply_filter ? binomialfilter[mfi].getFilterArrayR().dataPtr() : nullptr;
+    amrex::Real const* filter_z_arr = apply_filter ? binomialfilter[mfi].getFilterArrayZ().dataPtr() : nullptr;
+
     ParallelFor(spectralspace_bx, modes,
     [=] AMREX_GPU_DEVICE(int i, int j, int k, int mode) noexcept {
         Complex spectral_field_value = tmp_arr(i,j,k,mode);
         // Apply proper shift.
         if (!is_nodal_z) { spectral_field_value *= zshift_arr[j]; }
+        // Apply the k-space filter.
+        if (apply_filter) {
+            int const ir = i + nr*mode;
+            spectral_field_value *= filter_r_arr[ir]*filter_z_arr[j];
+        }
         // Copy field into the correct index.
         int const ic = field_index + mode*n_fields;
         fields_arr(i,j,k,ic) = spectral_field_value*inv_nz;
@@ -446,11 +459,12 @@ SpectralFieldDataRZ::FABZBackwardTransform (amrex::MFIter const & mfi, amrex::Bo
 
 /* \brief Transform the component `i_comp` of MultiFab `field_mf`
  *  to spectral space, and store the corresponding result internally
- *  (in the spectral field specified by `field_index`) */
+ *  (in the spectral field specified by `field_index`),
+ *  optionally applying the k-space filter */
 void
 SpectralFieldDataRZ::ForwardTransform (const int lev,
                                        amrex::MultiFab const & field_mf, int const field_index,
-                                       int const i_comp)
+                                       int const i_comp, bool const apply_filter)
 {
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, field_mf.boxArray(), field_mf.DistributionMap());
@@ -493,7 +507,7 @@ SpectralFieldDataRZ::ForwardTransform (const int lev,
         field_mf_copy[mfi].copy<amrex::RunOn::Device>(field_mf[mfi], i_comp*m_ncomps, 0, m_ncomps);
         multi_spectral_hankel_transformer[mfi].PhysicalToSpectral_Scalar(field_mf_copy[mfi], tempHTransformedSplit[mfi]);
 
-        FABZForwardTransform(mfi, realspace_bx, tempHTransformedSplit, field_index, is_nodal_z);
+        FABZForwardTransform(mfi, realspace_bx, tempHTransformedSplit, field_index, is_nodal_z, apply_filter);
 
         if (do_costs)
         {
@@ -506,11 +520,13 @@ SpectralFieldDataRZ::ForwardTransform (const int lev,
 
 /* \brief Transform the coupled components of MultiFabs `field_mf_r` and `field_mf_t`
  *  to spectral space, and store the corresponding result internally
- *  (in the spectral fields specified by `field_index_r` and `field_index_t`) */
+ *  (in the spectral fields specified by `field_index_r` and `field_index_t`),
+ *  optionally applying the k-space filter */
 void
 SpectralFieldDataRZ::ForwardTransform (const int lev,
                                        amrex::MultiFab const & field_mf_r, int const field_index_r,
-                                       amrex::MultiFab const & field_mf_t, int const field_index_t)
+                                       amrex::MultiFab const & field_mf_t, int const field_index_t,
+                                       bool const apply_filter)
 {
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, field_mf_r.boxArray(), field_mf_r.DistributionMap());
@@ -558,8 +574,8 @@ SpectralFieldDataRZ::ForwardTransform (const int lev,
                                                            field_mf_r_copy[mfi], field_mf_t_copy[mfi],
                                                            tempHTransformedSplit_p[mfi], tempHTransformedSplit_m[mfi]);
 
-        FABZForwardTransform(mfi, realspace_bx, tempHTransformedSplit_p, field_index_r, is_nodal_z);
-        FABZForwardTransform(mfi, realspace_bx, tempHTransformedSplit_m, field_index_t, is_nodal_z);
+        FABZForwardTransform(mfi, realspace_bx, tempHTransformedSplit_p, field_index_r, is_nodal_z, apply_filter);
+        FABZForwardTransform(mfi, realspace_bx, tempHTransformedSplit_m, field_index_t, is_nodal_z, apply_filter);
 
         if (do_costs)
         {
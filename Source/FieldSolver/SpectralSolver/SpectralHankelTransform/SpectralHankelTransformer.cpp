@@ -8,7 +8,10 @@
 
 #include "Utils/WarpXConst.H"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 SpectralHankelTransformer::SpectralHankelTransformer (int const nr,
                                                       int const n_rz_azimuthal_modes,
@@ -28,7 +31,80 @@ SpectralHankelTransformer::SpectralHankelTransformer (int const nr,
 
     ExtractKrArray();
 
+#ifdef AMREX_USE_GPU
+    int const device_id = amrex::Gpu::Device::deviceId();
+    blas::Queue::stream_t stream_id = amrex::Gpu::gpuStream();
+    m_queue = std::make_unique<blas::Queue>( device_id, stream_id );
+
+    // Gather the matrices of all the modes one after the other, so that the transforms
+    // of all the modes are done by one batched matrix product
+    auto const gather_matrices = [&] (amrex::Vector< std::unique_ptr<HankelTransform> > const & dht,
+                                      HankelTransform::RealVector & M,
+                                      HankelTransform::RealVector & invM)
+    {
+        auto const matrix_size = static_cast<std::size_t>(m_nr)*m_nr;
+        M.resize(matrix_size*m_n_rz_azimuthal_modes);
+        invM.resize(matrix_size*m_n_rz_azimuthal_modes);
+        for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+            auto const & M_mode = dht[mode]->getForwardMatrix();
+            auto const & invM_mode = dht[mode]->getInverseMatrix();
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToDevice, M_mode.begin(), M_mode.end(),
+                                  M.begin() + mode*matrix_size);
+            amrex::Gpu::copyAsync(amrex::Gpu::deviceToDevice, invM_mode.begin(), invM_mode.end(),
+                                  invM.begin() + mode*matrix_size);
+        }
+    };
+    gather_matrices(dht0, m_M0, m_invM0);
+    gather_matrices(dhtp, m_Mp, m_invMp);
+    gather_matrices(dhtm, m_Mm, m_invMm);
+    amrex::Gpu::synchronize();
+
+    // The per-mode transforms are not used on GPU
+    dht0.clear();
+    dhtp.clear();
+    dhtm.clear();
+#endif
+
+}
+
+#ifdef AMREX_USE_GPU
+void
+SpectralHankelTransformer::BatchedTransform (std::vector<amrex::Real*> const & matrices,
+                                             std::vector<amrex::Real*> const & inputs, int const ld_input,
+                                             std::vector<amrex::Real*> const & outputs, int const ld_output,
+                                             int const nz)
+{
+    using amrex::operator""_rt;
+
+    // All the entries of the batch have the same dimensions, so that blaspp calls the
+    // batched GEMM of the vendor library (m_nk == m_nr)
+    std::vector<blas::Op> const trans_matrix = {blas::Op::Trans};
+    std::vector<blas::Op> const trans_input = {blas::Op::NoTrans};
+    std::vector<int64_t> const m = {m_nr};
+    std::vector<int64_t> const n = {nz};
+    std::vector<int64_t> const k = {m_nr};
+    std::vector<amrex::Real> const alpha = {1._rt};
+    std::vector<amrex::Real> const beta = {0._rt};
+    std::vector<int64_t> const ld_matrices = {m_nr};
+    std::vector<int64_t> const ld_inputs = {ld_input};
+    std::vector<int64_t> const ld_outputs = {ld_output};
+    // Skip the checks of the arguments
+    std::vector<int64_t> info;
+
+    // We perform stream synchronization since `gemm` may be running
+    // on a different stream.
+    amrex::Gpu::streamSynchronize();
+
+    blas::batch::gemm(blas::Layout::ColMajor, trans_matrix, trans_input,
+                      m, n, k, alpha,
+                      matrices, ld_matrices,
+                      inputs, ld_inputs, beta,
+                      outputs, ld_outputs,
+                      matrices.size(), info, *m_queue);
+
+    amrex::Gpu::streamSynchronize();
 }
+#endif
 
 /* \brief Extracts the kr for all of the modes
  * This needs to be separate since the ParallelFor cannot be in the constructor. */
@@ -65,6 +141,25 @@ SpectralHankelTransformer::PhysicalToSpectral_Scalar (amrex::FArrayBox const & F
     // can be done.
     // Note that F_physical does not include the imaginary part of mode 0,
     // but G_spectral does.
+#ifdef AMREX_USE_GPU
+    // all the modes and components together
+    int const ngr = G_spectral.box().smallEnd(0) - F_physical.box().smallEnd(0);
+    AMREX_ALWAYS_ASSERT(m_nr == G_spectral.box().length(0) && ngr >= 0);
+    auto const matrix_size = static_cast<std::size_t>(m_nr)*m_nr;
+    std::vector<amrex::Real*> matrices, inputs, outputs;
+    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+        for (int ri=0 ; ri < 2 ; ri++) {
+            if (mode == 0 && ri == 1) { continue; }
+            int const icomp = (mode == 0) ? 0 : 2*mode - 1 + ri;
+            matrices.push_back(m_M0.dataPtr() + mode*matrix_size);
+            inputs.push_back(const_cast<amrex::Real*>(F_physical.dataPtr(icomp)) + ngr);
+            outputs.push_back(G_spectral.dataPtr(2*mode + ri));
+        }
+    }
+    BatchedTransform(matrices, inputs, F_physical.box().length(0), outputs, m_nr,
+                     F_physical.box().length(1));
+    G_spectral.setVal<amrex::RunOn::Device>(0., 1);
+#else
     for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
         int const mode_r = 2*mode;
         int const mode_i = 2*mode + 1;
@@ -73,11 +168,12 @@ SpectralHankelTransformer::PhysicalToSpectral_Scalar (amrex::FArrayBox const & F
             dht0[mode]->HankelForwardTransform(F_physical, icomp, G_spectral, mode_r);
             G_spectral.setVal<amrex::RunOn::Device>(0., mode_i);
         } else {
+            // real and imaginary parts together
             int const icomp = 2*mode - 1;
-            dht0[mode]->HankelForwardTransform(F_physical, icomp  , G_spectral, mode_r);
-            dht0[mode]->HankelForwardTransform(F_physical, icomp+1, G_spectral, mode_i);
+            dht0[mode]->HankelForwardTransform(F_physical, icomp, G_spectral, mode_r, 2);
         }
     }
+#endif
 }
 
 /* \brief Converts a vector field from the physical to the spectral space for all modes */
@@ -96,35 +192,54 @@ SpectralHankelTransformer::PhysicalToSpectral_Vector (amrex::Box const & box,
     amrex::Array4<amrex::Real> const & F_r_physical_array = F_r_physical.array();
     amrex::Array4<amrex::Real> const & F_t_physical_array = F_t_physical.array();
 
-    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
-
+    amrex::ParallelFor(box, m_n_rz_azimuthal_modes,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k, int mode)
+    {
         int const mode_r = 2*mode;
         int const mode_i = 2*mode + 1;
+        amrex::Real const r_real = F_r_physical_array(i,j,k,mode_r);
+        amrex::Real const r_imag = F_r_physical_array(i,j,k,mode_i);
+        amrex::Real const t_real = F_t_physical_array(i,j,k,mode_r);
+        amrex::Real const t_imag = F_t_physical_array(i,j,k,mode_i);
+        // Combine the values
+        // temp_p = (F_r - I*F_t)/2
+        // temp_m = (F_r + I*F_t)/2
+        F_r_physical_array(i,j,k,mode_r) = 0.5_rt*(r_real + t_imag);
+        F_r_physical_array(i,j,k,mode_i) = 0.5_rt*(r_imag - t_real);
+        F_t_physical_array(i,j,k,mode_r) = 0.5_rt*(r_real - t_imag);
+        F_t_physical_array(i,j,k,mode_i) = 0.5_rt*(r_imag + t_real);
+    });
 
-        amrex::ParallelFor(box,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k)
-        {
-            amrex::Real const r_real = F_r_physical_array(i,j,k,mode_r);
-            amrex::Real const r_imag = F_r_physical_array(i,j,k,mode_i);
-            amrex::Real const t_real = F_t_physical_array(i,j,k,mode_r);
-            amrex::Real const t_imag = F_t_physical_array(i,j,k,mode_i);
-            // Combine the values
-            // temp_p = (F_r - I*F_t)/2
-            // temp_m = (F_r + I*F_t)/2
-            F_r_physical_array(i,j,k,mode_r) = 0.5_rt*(r_real + t_imag);
-            F_r_physical_array(i,j,k,mode_i) = 0.5_rt*(r_imag - t_real);
-            F_t_physical_array(i,j,k,mode_r) = 0.5_rt*(r_real - t_imag);
-            F_t_physical_array(i,j,k,mode_i) = 0.5_rt*(r_imag + t_real);
-        });
-
-        amrex::Gpu::streamSynchronize();
-
-        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_r, G_p_spectral, mode_r);
-        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_i, G_p_spectral, mode_i);
-        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_r, G_m_spectral, mode_r);
-        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_i, G_m_spectral, mode_i);
+    amrex::Gpu::streamSynchronize();
 
+#ifdef AMREX_USE_GPU
+    // all the modes and components, of both the + and - data, together
+    AMREX_ALWAYS_ASSERT(F_r_physical.box() == F_t_physical.box());
+    AMREX_ALWAYS_ASSERT(G_p_spectral.box() == G_m_spectral.box());
+    int const ngr = G_p_spectral.box().smallEnd(0) - F_r_physical.box().smallEnd(0);
+    AMREX_ALWAYS_ASSERT(m_nr == G_p_spectral.box().length(0) && ngr >= 0);
+    auto const matrix_size = static_cast<std::size_t>(m_nr)*m_nr;
+    std::vector<amrex::Real*> matrices, inputs, outputs;
+    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+        for (int icomp=2*mode ; icomp < 2*mode + 2 ; icomp++) {
+            matrices.push_back(m_Mp.dataPtr() + mode*matrix_size);
+            inputs.push_back(F_r_physical.dataPtr(icomp) + ngr);
+            outputs.push_back(G_p_spectral.dataPtr(icomp));
+            matrices.push_back(m_Mm.dataPtr() + mode*matrix_size);
+            inputs.push_back(F_t_physical.dataPtr(icomp) + ngr);
+            outputs.push_back(G_m_spectral.dataPtr(icomp));
+        }
     }
+    BatchedTransform(matrices, inputs, F_r_physical.box().length(0), outputs, m_nr,
+                     F_r_physical.box().length(1));
+#else
+    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+        int const mode_r = 2*mode;
+        // real and imaginary parts together
+        dhtp[mode]->HankelForwardTransform(F_r_physical, mode_r, G_p_spectral, mode_r, 2);
+        dhtm[mode]->HankelForwardTransform(F_t_physical, mode_r, G_m_spectral, mode_r, 2);
+    }
+#endif
 }
 
 /* \brief Converts a scalar field from the spectral to the physical space for all modes */
@@ -140,18 +255,36 @@ SpectralHankelTransformer::SpectralToPhysical_Scalar (amrex::FArrayBox const & G
 
     amrex::Gpu::streamSynchronize();
 
+#ifdef AMREX_USE_GPU
+    // all the modes and components together
+    int const ngr = G_spectral.box().smallEnd(0) - F_physical.box().smallEnd(0);
+    AMREX_ALWAYS_ASSERT(m_nr == G_spectral.box().length(0) && ngr >= 0);
+    auto const matrix_size = static_cast<std::size_t>(m_nr)*m_nr;
+    std::vector<amrex::Real*> matrices, inputs, outputs;
+    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+        for (int ri=0 ; ri < 2 ; ri++) {
+            if (mode == 0 && ri == 1) { continue; }
+            int const icomp = (mode == 0) ? 0 : 2*mode - 1 + ri;
+            matrices.push_back(m_invM0.dataPtr() + mode*matrix_size);
+            inputs.push_back(const_cast<amrex::Real*>(G_spectral.dataPtr(2*mode + ri)));
+            outputs.push_back(F_physical.dataPtr(icomp) + ngr);
+        }
+    }
+    BatchedTransform(matrices, inputs, m_nr, outputs, F_physical.box().length(0),
+                     F_physical.box().length(1));
+#else
     for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
         int const mode_r = 2*mode;
-        int const mode_i = 2*mode + 1;
         if (mode == 0) {
             int const icomp = 0;
             dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp);
         } else {
+            // real and imaginary parts together
             int const icomp = 2*mode - 1;
-            dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp);
-            dht0[mode]->HankelInverseTransform(G_spectral, mode_i, F_physical, icomp+1);
+            dht0[mode]->HankelInverseTransform(G_spectral, mode_r, F_physical, icomp, 2);
         }
     }
+#endif
 }
 
 /* \brief Converts a vector field from the spectral to the physical space for all modes */
@@ -167,35 +300,54 @@ SpectralHankelTransformer::SpectralToPhysical_Vector (amrex::Box const & box,
     amrex::Array4<amrex::Real> const & F_r_physical_array = F_r_physical.array();
     amrex::Array4<amrex::Real> const & F_t_physical_array = F_t_physical.array();
 
-    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+    amrex::Gpu::streamSynchronize();
 
+#ifdef AMREX_USE_GPU
+    // all the modes and components, of both the + and - data, together
+    AMREX_ALWAYS_ASSERT(F_r_physical.box() == F_t_physical.box());
+    AMREX_ALWAYS_ASSERT(G_p_spectral.box() == G_m_spectral.box());
+    int const ngr = G_p_spectral.box().smallEnd(0) - F_r_physical.box().smallEnd(0);
+    AMREX_ALWAYS_ASSERT(m_nr == G_p_spectral.box().length(0) && ngr >= 0);
+    auto const matrix_size = static_cast<std::size_t>(m_nr)*m_nr;
+    std::vector<amrex::Real*> matrices, inputs, outputs;
+    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
+        for (int icomp=2*mode ; icomp < 2*mode + 2 ; icomp++) {
+            matrices.push_back(m_invMp.dataPtr() + mode*matrix_size);
+            inputs.push_back(const_cast<amrex::Real*>(G_p_spectral.dataPtr(icomp)));
+            outputs.push_back(F_r_physical.dataPtr(icomp) + ngr);
+            matrices.push_back(m_invMm.dataPtr() + mode*matrix_size);
+            inputs.push_back(const_cast<amrex::Real*>(G_m_spectral.dataPtr(icomp)));
+            outputs.push_back(F_t_physical.dataPtr(icomp) + ngr);
+        }
+    }
+    BatchedTransform(matrices, inputs, m_nr, outputs, F_r_physical.box().length(0),
+                     F_r_physical.box().length(1));
+#else
+    for (int mode=0 ; mode < m_n_rz_azimuthal_modes ; mode++) {
         int const mode_r = 2*mode;
-        int const mode_i = 2*mode + 1;
-
-        amrex::Gpu::streamSynchronize();
-
-        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_r, F_r_physical, mode_r);
-        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_i, F_r_physical, mode_i);
-        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_r, F_t_physical, mode_r);
-        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_i, F_t_physical, mode_i);
-
-        amrex::Gpu::streamSynchronize();
+        // real and imaginary parts together
+        dhtp[mode]->HankelInverseTransform(G_p_spectral, mode_r, F_r_physical, mode_r, 2);
+        dhtm[mode]->HankelInverseTransform(G_m_spectral, mode_r, F_t_physical, mode_r, 2);
+    }
+#endif
 
-        amrex::ParallelFor(box,
-        [=] AMREX_GPU_DEVICE (int i, int j, int k)
-        {
-            amrex::Real const p_real = F_r_physical_array(i,j,k,mode_r);
-            amrex::Real const p_imag = F_r_physical_array(i,j,k,mode_i);
-            amrex::Real const m_real = F_t_physical_array(i,j,k,mode_r);
-            amrex::Real const m_imag = F_t_physical_array(i,j,k,mode_i);
-            // Combine the values
-            // F_r =    G_p + G_m
-            // F_t = I*(G_p - G_m)
-            F_r_physical_array(i,j,k,mode_r) =  p_real + m_real;
-            F_r_physical_array(i,j,k,mode_i) =  p_imag + m_imag;
-            F_t_physical_array(i,j,k,mode_r) = -p_imag + m_imag;
-            F_t_physical_array(i,j,k,mode_i) =  p_real - m_real;
-        });
+    amrex::Gpu::streamSynchronize();
 
-    }
+    amrex::ParallelFor(box, m_n_rz_azimuthal_modes,
+    [=] AMREX_GPU_DEVICE (int i, int j, int k, int mode)
+    {
+        int const mode_r = 2*mode;
+        int const mode_i = 2*mode + 1;
+        amrex::Real const p_real = F_r_physical_array(i,j,k,mode_r);
+        amrex::Real const p_imag = F_r_physical_array(i,j,k,mode_i);
+        amrex::Real const m_real = F_t_physical_array(i,j,k,mode_r);
+        amrex::Real const m_imag = F_t_physical_array(i,j,k,mode_i);
+        // Combine the values
+        // F_r =    G_p + G_m
+        // F_t = I*(G_p - G_m)
+        F_r_physical_array(i,j,k,mode_r) =  p_real + m_real;
+        F_r_physical_array(i,j,k,mode_i) =  p_imag + m_imag;
+        F_t_physical_array(i,j,k,mode_r) = -p_imag + m_imag;
+        F_t_physical_array(i,j,k,mode_i) =  p_real - m_real;
+    });
 }
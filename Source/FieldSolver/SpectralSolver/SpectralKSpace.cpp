@@ -21,6 +21,11 @@
 #include <AMReX_IndexType.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+
+#ifdef WARPX_USE_HEFFTE
+#   include <heffte.h>
+#endif
 
 #include <array>
 #include <cmath>
@@ -75,9 +80,84 @@ SpectralKSpace::SpectralKSpace( const BoxArray& realspace_ba,
     }
 }
 
+#ifdef WARPX_USE_HEFFTE
+/* \brief Initialize k space object for a distributed FFT over the whole domain.
+ *
+ * The real-space domain and the spectral space are each split in one box per
+ * MPI rank (box i is owned by rank i), as done by heFFTe. The distributed FFT
+ * transposes the data between these decompositions (through pencils).
+ *
+ * \param realspace_domain Cell-centered box of the whole (periodic) domain
+ * \param realspace_dx Cell size of the grid in real space
+ */
+SpectralKSpace::SpectralKSpace( const Box& realspace_domain,
+                                const RealVect realspace_dx )
+    : dx(realspace_dx)  // Store the cell size as member `dx`
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        realspace_domain.ixType()==IndexType::TheCellType(),
+        "SpectralKSpace expects a cell-centered box.");
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    const IntVect fft_size = realspace_domain.length();
+
+    // heFFTe boxes are always 3D, with the first axis contiguous in memory
+    // (as in AMReX Fortran-order arrays); unused dimensions have one point
+    std::array<int,3> real_hi = {0, 0, 0};
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { real_hi[idim] = fft_size[idim] - 1; }
+    std::array<int,3> spectral_hi = real_hi;
+    spectral_hi[0] = fft_size[0]/2; // real-to-complex FFT along the first axis
+
+    const heffte::box3d<> real_world({0, 0, 0}, real_hi);
+    const heffte::box3d<> spectral_world({0, 0, 0}, spectral_hi);
+
+    const std::vector<heffte::box3d<>> real_boxes = heffte::split_world(
+        real_world, heffte::proc_setup_min_surface(real_world, nprocs));
+    const std::vector<heffte::box3d<>> spectral_boxes = heffte::split_world(
+        spectral_world, heffte::proc_setup_min_surface(spectral_world, nprocs));
+
+    BoxList real_bl;
+    BoxList spectral_bl;
+    for (int i = 0; i < nprocs; ++i) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !real_boxes[i].empty() && !spectral_boxes[i].empty(),
+            "Distributed FFT: the domain is too small for the number of MPI ranks");
+        const auto& rb = real_boxes[i];
+        const auto& sb = spectral_boxes[i];
+        // Real-space boxes are shifted to the index space of the domain
+        real_bl.push_back(Box(
+            IntVect(AMREX_D_DECL(rb.low[0], rb.low[1], rb.low[2])),
+            IntVect(AMREX_D_DECL(rb.high[0], rb.high[1], rb.high[2])))
+            + realspace_domain.smallEnd());
+        spectral_bl.push_back(Box(
+            IntVect(AMREX_D_DECL(sb.low[0], sb.low[1], sb.low[2])),
+            IntVect(AMREX_D_DECL(sb.high[0], sb.high[1], sb.high[2]))));
+    }
+    realspace_fft_ba.define(real_bl);
+    spectralspace_ba.define(spectral_bl);
+
+    // Box i is owned by MPI rank i, as in heFFTe
+    Vector<int> pmap(nprocs);
+    for (int i = 0; i < nprocs; ++i) { pmap[i] = i; }
+    fft_dm.define(pmap);
+
+    // The k vectors of each box cover the whole spectral domain
+    const BoxArray domain_ba(BoxList(Vector<Box>(nprocs, realspace_domain)));
+    for (int i_dim=0; i_dim<AMREX_SPACEDIM; i_dim++) {
+        // Real-to-complex FFTs: first axis contains only the positive k
+        const auto only_positive_k = (i_dim==0);
+        k_vec[i_dim] = getKComponent(fft_dm, domain_ba, i_dim, only_positive_k);
+    }
+}
+#endif
+
 /* For each box, in `spectralspace_ba`, which is owned by the local MPI rank
  * (as indicated by the argument `dm`), compute the values of the
  * corresponding k coordinate along the dimension specified by `i_dim`
+ *
+ * The k vector is computed from index 0 to the end of the spectral domain of
+ * the FFT, so that it can be accessed with the indices of the spectral box
+ * (which starts at 0 for local FFTs, but not for distributed FFTs).
  */
 KVectorComponent
 SpectralKSpace::getKComponent( const DistributionMapping& dm,
@@ -93,17 +173,17 @@ SpectralKSpace::getKComponent( const DistributionMapping& dm,
         const Box bx = spectralspace_ba[mfi];
         Gpu::DeviceVector<Real>& k = k_comp[mfi];
 
-        // Allocate k to the right size
-        const int N = bx.length( i_dim );
+        // Allocate k to the size of the spectral domain of the FFT
+        IntVect fft_size = realspace_ba[mfi].length();
+        const int N = (only_positive_k) ? fft_size[i_dim]/2 + 1 : fft_size[i_dim];
         k.resize( N );
         Real* pk = k.data();
 
         // Fill the k vector
-        IntVect fft_size = realspace_ba[mfi].length();
         const Real dk = 2*MathConst::pi/(fft_size[i_dim]*dx[i_dim]);
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.smallEnd(i_dim) == 0,
-            "Expected box to start at 0, in spectral space.");
-        WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.bigEnd(i_dim) == N-1,
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.smallEnd(i_dim) >= 0,
+            "Expected box to start at 0 or above, in spectral space.");
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE( bx.bigEnd(i_dim) <= N-1,
             "Expected different box end index in spectral space.");
         if (only_positive_k){
             // Fill the full axis with positive k values
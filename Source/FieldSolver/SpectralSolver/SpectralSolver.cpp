@@ -35,20 +35,33 @@ SpectralSolver::SpectralSolver (
                 const amrex::Vector<amrex::Real>& v_comoving,
                 const amrex::RealVect dx, const amrex::Real dt,
                 const bool pml, const bool periodic_single_box,
+                const bool distributed_fft,
                 const bool update_with_rho,
                 const bool fft_do_time_averaging,
                 const PSATDSolutionType psatd_solution_type,
                 const JInTime J_in_time,
                 const RhoInTime rho_in_time,
                 const bool dive_cleaning,
-                const bool divb_cleaning)
+                const bool divb_cleaning,
+                const bool on_the_fly_coefficients)
 {
     // Initialize all structures using the same distribution mapping dm
 
     // - Initialize k space object (Contains info about the size of
     // the spectral space corresponding to each box in `realspace_ba`,
     // as well as the value of the corresponding k coordinates)
+    // With distributed FFTs, the spectral space is decomposed over all MPI ranks,
+    // independently of the decomposition of the fields in real space
+#ifdef WARPX_USE_HEFFTE
+    const SpectralKSpace k_space = (distributed_fft) ?
+        SpectralKSpace(realspace_ba.minimalBox(), dx) :
+        SpectralKSpace(realspace_ba, dm, dx);
+#else
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!distributed_fft,
+        "psatd.distributed_fft=1 requires WarpX to be compiled with heFFTe (WarpX_HEFFTE=ON)");
     const SpectralKSpace k_space= SpectralKSpace(realspace_ba, dm, dx);
+#endif
+    const amrex::DistributionMapping& spectral_dm = (distributed_fft) ? k_space.fft_dm : dm;
 
     m_spectral_index = SpectralFieldIndex(
         update_with_rho, fft_do_time_averaging, J_in_time, rho_in_time,
@@ -60,7 +73,7 @@ SpectralSolver::SpectralSolver (
     if (pml) // PSATD or Galilean PSATD equations in the PML region
     {
         algorithm = std::make_unique<PsatdAlgorithmPml>(
-            k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
+            k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
             v_galilean, dt, dive_cleaning, divb_cleaning);
     }
     else // PSATD equations in the regular domain
@@ -69,14 +82,14 @@ SpectralSolver::SpectralSolver (
         if (v_comoving[0] != 0. || v_comoving[1] != 0. || v_comoving[2] != 0.)
         {
             algorithm = std::make_unique<PsatdAlgorithmComoving>(
-                k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
+                k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
                 v_comoving, dt, update_with_rho);
         }
         // Galilean PSATD algorithm (only J constant in time)
         else if (v_galilean[0] != 0. || v_galilean[1] != 0. || v_galilean[2] != 0.)
         {
             algorithm = std::make_unique<PsatdAlgorithmJConstantInTime>(
-                k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
+                k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
                 v_galilean, dt, update_with_rho, fft_do_time_averaging,
                 dive_cleaning, divb_cleaning);
         }
@@ -93,7 +106,7 @@ SpectralSolver::SpectralSolver (
             const bool div_cleaning = (dive_cleaning && divb_cleaning);
 
             algorithm = std::make_unique<PsatdAlgorithmFirstOrder>(
-                k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
+                k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
                 dt, div_cleaning, J_in_time, rho_in_time);
         }
         else if (psatd_solution_type == PSATDSolutionType::SecondOrder)
@@ -101,22 +114,38 @@ SpectralSolver::SpectralSolver (
             if (J_in_time == JInTime::Constant)
             {
                 algorithm = std::make_unique<PsatdAlgorithmJConstantInTime>(
-                    k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
+                    k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
                     v_galilean, dt, update_with_rho, fft_do_time_averaging,
                     dive_cleaning, divb_cleaning);
             }
             else if (J_in_time == JInTime::Linear)
             {
                 algorithm = std::make_unique<PsatdAlgorithmJLinearInTime>(
-                    k_space, dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
-                    dt, fft_do_time_averaging, dive_cleaning, divb_cleaning);
+                    k_space, spectral_dm, m_spectral_index, norder_x, norder_y, norder_z, grid_type,
+                    dt, fft_do_time_averaging, dive_cleaning, divb_cleaning,
+                    on_the_fly_coefficients);
             }
         }
     }
 
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !on_the_fly_coefficients || pml ||
+        dynamic_cast<PsatdAlgorithmJLinearInTime*>(algorithm.get()) != nullptr,
+        "psatd.on_the_fly_coefficients=1 is only supported with psatd.solution_type=second-order"
+        " and psatd.J_in_time=linear");
+
     // - Initialize arrays for fields in spectral space + FFT plans
-    field_data = SpectralFieldData(lev, realspace_ba, k_space, dm,
-                                   m_spectral_index.n_fields, periodic_single_box);
+    field_data = SpectralFieldData(lev, realspace_ba, k_space, spectral_dm,
+                                   m_spectral_index.n_fields, periodic_single_box,
+                                   distributed_fft);
+}
+
+amrex::Long
+SpectralSolver::JLinearInTimeCoefficientsBytes () const
+{
+    const auto* const algorithm_j_linear =
+        dynamic_cast<PsatdAlgorithmJLinearInTime const*>(algorithm.get());
+    return (algorithm_j_linear) ? algorithm_j_linear->CoefficientsBytes() : 0;
 }
 
 void
@@ -140,6 +169,25 @@ SpectralSolver::BackwardTransform( const int lev,
     field_data.BackwardTransform(lev, mf, field_index, fill_guards, i_comp);
 }
 
+void
+SpectralSolver::ForwardTransform (const int lev,
+                                  const std::array<const amrex::MultiFab*, 3>& mf,
+                                  const std::array<int, 3>& field_index)
+{
+    WARPX_PROFILE("SpectralSolver::ForwardTransformBatch");
+    field_data.ForwardTransform(lev, mf, field_index);
+}
+
+void
+SpectralSolver::BackwardTransform( const int lev,
+                                   const std::array<amrex::MultiFab*, 3>& mf,
+                                   const std::array<int, 3>& field_index,
+                                   const amrex::IntVect& fill_guards )
+{
+    WARPX_PROFILE("SpectralSolver::BackwardTransformBatch");
+    field_data.BackwardTransform(lev, mf, field_index, fill_guards);
+}
+
 void
 SpectralSolver::pushSpectralFields(){
     WARPX_PROFILE("SpectralSolver::pushSpectralFields");
@@ -82,9 +82,9 @@ SpectralSolverRZ::SpectralSolverRZ (const int lev,
 void
 SpectralSolverRZ::ForwardTransform (const int lev,
                                     amrex::MultiFab const & field_mf, int const field_index,
-                                    int const i_comp) {
+                                    int const i_comp, bool const apply_filter) {
     WARPX_PROFILE("SpectralSolverRZ::ForwardTransform");
-    field_data.ForwardTransform(lev, field_mf, field_index, i_comp);
+    field_data.ForwardTransform(lev, field_mf, field_index, i_comp, apply_filter);
 }
 
 /* \brief Transform the two MultiFabs `field_mf1` and `field_mf2`
@@ -93,11 +93,13 @@ SpectralSolverRZ::ForwardTransform (const int lev,
 void
 SpectralSolverRZ::ForwardTransform (const int lev,
                                     amrex::MultiFab const & field_mf1, int const field_index1,
-                                    amrex::MultiFab const & field_mf2, int const field_index2) {
+                                    amrex::MultiFab const & field_mf2, int const field_index2,
+                                    bool const apply_filter) {
     WARPX_PROFILE("SpectralSolverRZ::ForwardTransform");
     field_data.ForwardTransform(lev,
                                 field_mf1, field_index1,
-                                field_mf2, field_index2);
+                                field_mf2, field_index2,
+                                apply_filter);
 }
 
 /* \brief Transform spectral field specified by `field_index` back to
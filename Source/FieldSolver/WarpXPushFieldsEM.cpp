@@ -28,6 +28,8 @@
 #include "WarpXPushFieldsEM_K.H"
 #include "WarpX_FDTD.H"
 
+#include <ablastr/utils/Communication.H>
+
 #include <AMReX.H>
 #ifdef AMREX_USE_SENSEI_INSITU
 #   include <AMReX_AmrMeshInSituBridge.H>
@@ -65,15 +67,19 @@ namespace {
         SpectralSolver& solver,
 #endif
         const std::array<std::unique_ptr<amrex::MultiFab>,3>& vector_field,
-        const int compx, const int compy, const int compz)
+        const int compx, const int compy, const int compz,
+        const bool apply_kspace_filter = false)
     {
 #ifdef WARPX_DIM_RZ
-        solver.ForwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy);
-        solver.ForwardTransform(lev, *vector_field[2], compz);
+        // The k-space filter is applied within the forward transforms
+        solver.ForwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy, apply_kspace_filter);
+        solver.ForwardTransform(lev, *vector_field[2], compz, 0, apply_kspace_filter);
 #else
-        solver.ForwardTransform(lev, *vector_field[0], compx);
-        solver.ForwardTransform(lev, *vector_field[1], compy);
-        solver.ForwardTransform(lev, *vector_field[2], compz);
+        amrex::ignore_unused(apply_kspace_filter);
+        // Transform the three components in one batch of FFTs
+        solver.ForwardTransform(lev,
+            {vector_field[0].get(), vector_field[1].get(), vector_field[2].get()},
+            {compx, compy, compz});
 #endif
     }
 
@@ -93,9 +99,10 @@ namespace {
         solver.BackwardTransform(lev, *vector_field[0], compx, *vector_field[1], compy);
         solver.BackwardTransform(lev, *vector_field[2], compz);
 #else
-        solver.BackwardTransform(lev, *vector_field[0], compx, fill_guards);
-        solver.BackwardTransform(lev, *vector_field[1], compy, fill_guards);
-        solver.BackwardTransform(lev, *vector_field[2], compz, fill_guards);
+        // Transform the three components in one batch of FFTs
+        solver.BackwardTransform(lev,
+            {vector_field[0].get(), vector_field[1].get(), vector_field[2].get()},
+            {compx, compy, compz}, fill_guards);
 #endif
     }
 }
@@ -277,6 +284,9 @@ void WarpX::PSATDForwardTransformJ (
     SpectralFieldIndex Idx;
     int idx_jx, idx_jy, idx_jz;
 
+    // Apply filter in k space if needed (RZ only), fused with the forward transforms
+    const bool do_kspace_filter = use_kspace_filter && apply_kspace_filter;
+
     for (int lev = 0; lev <= finest_level; ++lev)
     {
         Idx = spectral_solver_fp[lev]->m_spectral_index;
@@ -285,7 +295,7 @@ void WarpX::PSATDForwardTransformJ (
         idx_jy = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jy_new) : static_cast<int>(Idx.Jy_mid);
         idx_jz = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jz_new) : static_cast<int>(Idx.Jz_mid);
 
-        ForwardTransformVect(lev, *spectral_solver_fp[lev], J_fp[lev], idx_jx, idx_jy, idx_jz);
+        ForwardTransformVect(lev, *spectral_solver_fp[lev], J_fp[lev], idx_jx, idx_jy, idx_jz, do_kspace_filter);
 
         if (spectral_solver_cp[lev])
         {
@@ -295,39 +305,9 @@ void WarpX::PSATDForwardTransformJ (
             idx_jy = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jy_new) : static_cast<int>(Idx.Jy_mid);
             idx_jz = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jz_new) : static_cast<int>(Idx.Jz_mid);
 
-            ForwardTransformVect(lev, *spectral_solver_cp[lev], J_cp[lev], idx_jx, idx_jy, idx_jz);
-        }
-    }
-
-#ifdef WARPX_DIM_RZ
-    // Apply filter in k space if needed
-    if (use_kspace_filter && apply_kspace_filter)
-    {
-        for (int lev = 0; lev <= finest_level; ++lev)
-        {
-            Idx = spectral_solver_fp[lev]->m_spectral_index;
-
-            idx_jx = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jx_new) : static_cast<int>(Idx.Jx_mid);
-            idx_jy = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jy_new) : static_cast<int>(Idx.Jy_mid);
-            idx_jz = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jz_new) : static_cast<int>(Idx.Jz_mid);
-
-            spectral_solver_fp[lev]->ApplyFilter(lev, idx_jx, idx_jy, idx_jz);
-
-            if (spectral_solver_cp[lev])
-            {
-                Idx = spectral_solver_cp[lev]->m_spectral_index;
-
-                idx_jx = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jx_new) : static_cast<int>(Idx.Jx_mid);
-                idx_jy = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jy_new) : static_cast<int>(Idx.Jy_mid);
-                idx_jz = (J_in_time == JInTime::Linear) ? static_cast<int>(Idx.Jz_new) : static_cast<int>(Idx.Jz_mid);
-
-                spectral_solver_cp[lev]->ApplyFilter(lev, idx_jx, idx_jy, idx_jz);
-            }
+            ForwardTransformVect(lev, *spectral_solver_cp[lev], J_cp[lev], idx_jx, idx_jy, idx_jz, do_kspace_filter);
         }
     }
-#else
-    amrex::ignore_unused(apply_kspace_filter);
-#endif
 }
 
 void WarpX::PSATDBackwardTransformJ (
@@ -373,33 +353,31 @@ void WarpX::PSATDForwardTransformRho (
 {
     if (charge_fp[0] == nullptr) { return; }
 
+#ifdef WARPX_DIM_RZ
+    // Apply filter in k space if needed, fused with the forward transforms
+    const bool do_kspace_filter = use_kspace_filter && apply_kspace_filter;
+#else
+    amrex::ignore_unused(apply_kspace_filter);
+#endif
+
     for (int lev = 0; lev <= finest_level; ++lev)
     {
-        if (charge_fp[lev]) { spectral_solver_fp[lev]->ForwardTransform(lev, *charge_fp[lev], dcomp, icomp); }
+#ifdef WARPX_DIM_RZ
+        if (charge_fp[lev]) { spectral_solver_fp[lev]->ForwardTransform(lev, *charge_fp[lev], dcomp, icomp, do_kspace_filter); }
 
         if (spectral_solver_cp[lev])
         {
-            if (charge_cp[lev]) { spectral_solver_cp[lev]->ForwardTransform(lev, *charge_cp[lev], dcomp, icomp); }
+            if (charge_cp[lev]) { spectral_solver_cp[lev]->ForwardTransform(lev, *charge_cp[lev], dcomp, icomp, do_kspace_filter); }
         }
-    }
+#else
+        if (charge_fp[lev]) { spectral_solver_fp[lev]->ForwardTransform(lev, *charge_fp[lev], dcomp, icomp); }
 
-#ifdef WARPX_DIM_RZ
-    // Apply filter in k space if needed
-    if (use_kspace_filter && apply_kspace_filter)
-    {
-        for (int lev = 0; lev <= finest_level; ++lev)
+        if (spectral_solver_cp[lev])
         {
-            spectral_solver_fp[lev]->ApplyFilter(lev, dcomp);
-
-            if (spectral_solver_cp[lev])
-            {
-                spectral_solver_cp[lev]->ApplyFilter(lev, dcomp);
-            }
+            if (charge_cp[lev]) { spectral_solver_cp[lev]->ForwardTransform(lev, *charge_cp[lev], dcomp, icomp); }
         }
-    }
-#else
-    amrex::ignore_unused(apply_kspace_filter);
 #endif
+    }
 }
 
 void WarpX::PSATDCurrentCorrection ()
@@ -756,16 +734,21 @@ WarpX::PushPSATD ()
         PSATDForwardTransformRho(rho_fp, rho_cp, 1, rho_new);
     }
 
-    // FFT of E and B
-    PSATDForwardTransformEB(Efield_fp, Bfield_fp, Efield_cp, Bfield_cp);
+    // FFT of E and B, unless they are still in spectral space from the previous push
+    // (see psatd.keep_fields_in_spectral_space)
+    if (!m_psatd_spectral_fields_current) {
+        PSATDForwardTransformEB(Efield_fp, Bfield_fp, Efield_cp, Bfield_cp);
+    }
 
 #ifdef WARPX_DIM_RZ
     if (pml_rz[0]) { pml_rz[0]->PushPSATD(0); }
 #endif
 
     // FFT of F and G
-    if (WarpX::do_dive_cleaning) { PSATDForwardTransformF(); }
-    if (WarpX::do_divb_cleaning) { PSATDForwardTransformG(); }
+    if (!m_psatd_spectral_fields_current) {
+        if (WarpX::do_dive_cleaning) { PSATDForwardTransformF(); }
+        if (WarpX::do_divb_cleaning) { PSATDForwardTransformG(); }
+    }
 
     // Update E, B, F, and G in k-space
     PSATDPushSpectralFields();
@@ -777,6 +760,7 @@ WarpX::PushPSATD ()
     }
     if (WarpX::do_dive_cleaning) { PSATDBackwardTransformF(); }
     if (WarpX::do_divb_cleaning) { PSATDBackwardTransformG(); }
+    m_psatd_spectral_fields_current = fft_keep_fields_in_spectral_space;
 
     // Evolve the fields in the PML boxes
     for (int lev = 0; lev <= finest_level; ++lev)
@@ -816,20 +800,24 @@ WarpX::EvolveB (int lev, amrex::Real a_dt, DtType a_dt_type)
 }
 
 void
-WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type)
+WarpX::EvolveB (int lev, PatchType patch_type, amrex::Real a_dt, DtType a_dt_type,
+                FieldPushRegion region)
 {
 
     // Evolve B field in regular cells
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveB(Bfield_fp[lev], Efield_fp[lev], G_fp[lev],
                                        m_face_areas[lev], m_area_mod[lev], ECTRhofield[lev], Venl[lev],
-                                       m_flag_info_face[lev], m_borrowing[lev], lev, a_dt);
+                                       m_flag_info_face[lev], m_borrowing[lev], lev, a_dt, region);
     } else {
         m_fdtd_solver_cp[lev]->EvolveB(Bfield_cp[lev], Efield_cp[lev], G_cp[lev],
                                        m_face_areas[lev], m_area_mod[lev], ECTRhofield[lev], Venl[lev],
-                                       m_flag_info_face[lev], m_borrowing[lev], lev, a_dt);
+                                       m_flag_info_face[lev], m_borrowing[lev], lev, a_dt, region);
     }
 
+    // the interior push is completed by the boundary push
+    if (region == FieldPushRegion::Interior) { return; }
+
     // Evolve B field in PML cells
     if (do_pml && pml[lev]->ok()) {
         if (patch_type == PatchType::fine) {
@@ -869,21 +857,24 @@ WarpX::EvolveE (int lev, amrex::Real a_dt)
 }
 
 void
-WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
+WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt, FieldPushRegion region)
 {
     // Evolve E field in regular cells
     if (patch_type == PatchType::fine) {
         m_fdtd_solver_fp[lev]->EvolveE(Efield_fp[lev], Bfield_fp[lev],
                                        current_fp[lev], m_edge_lengths[lev],
                                        m_face_areas[lev], ECTRhofield[lev],
-                                       F_fp[lev], lev, a_dt );
+                                       F_fp[lev], lev, a_dt, region );
     } else {
         m_fdtd_solver_cp[lev]->EvolveE(Efield_cp[lev], Bfield_cp[lev],
                                        current_cp[lev], m_edge_lengths[lev],
                                        m_face_areas[lev], ECTRhofield[lev],
-                                       F_cp[lev], lev, a_dt );
+                                       F_cp[lev], lev, a_dt, region );
     }
 
+    // the interior push is completed by the boundary push
+    if (region == FieldPushRegion::Interior) { return; }
+
     // Evolve E field in PML cells
     if (do_pml && pml[lev]->ok()) {
         if (patch_type == PatchType::fine) {
@@ -921,6 +912,105 @@ WarpX::EvolveE (int lev, PatchType patch_type, amrex::Real a_dt)
 }
 
 
+void
+WarpX::FillBoundaryBAndEvolveE (amrex::Real a_dt, amrex::IntVect ng)
+{
+    WARPX_PROFILE("WarpX::FillBoundaryBAndEvolveE()");
+
+    // only level 0, without PML (see the checks of warpx.do_fdtd_comm_overlap)
+    int const lev = 0;
+    amrex::Vector<amrex::MultiFab*> mf;
+    amrex::Vector<amrex::IntVect> nghost;
+    for (auto const& B : Bfield_fp[lev]) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ng.allLE(B->nGrowVect()),
+            "Error: in FillBoundaryBAndEvolveE, requested more guard cells than allocated");
+        mf.push_back(B.get());
+        nghost.push_back((safe_guard_cells) ? B->nGrowVect() : ng);
+    }
+
+    auto request = ablastr::utils::communication::FillBoundary_nowait(
+        mf, nghost, WarpX::do_single_precision_comms, Geom(lev).periodicity(),
+        WarpX::sync_nodal_points);
+    EvolveE(lev, PatchType::fine, a_dt, FieldPushRegion::Interior);
+    ablastr::utils::communication::FillBoundary_finish(request);
+    EvolveE(lev, PatchType::fine, a_dt, FieldPushRegion::Boundary);
+
+    // Allow execution of Python callback after E-field push
+    ExecutePythonCallback("afterEpush");
+}
+
+void
+WarpX::FillBoundaryEAndEvolveB (amrex::Real a_dt, DtType a_dt_type, amrex::IntVect ng)
+{
+    WARPX_PROFILE("WarpX::FillBoundaryEAndEvolveB()");
+
+    // only level 0, without PML (see the checks of warpx.do_fdtd_comm_overlap)
+    int const lev = 0;
+    amrex::Vector<amrex::MultiFab*> mf;
+    amrex::Vector<amrex::IntVect> nghost;
+    for (auto const& E : Efield_fp[lev]) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            ng.allLE(E->nGrowVect()),
+            "Error: in FillBoundaryEAndEvolveB, requested more guard cells than allocated");
+        mf.push_back(E.get());
+        nghost.push_back((safe_guard_cells) ? E->nGrowVect() : ng);
+    }
+
+    auto request = ablastr::utils::communication::FillBoundary_nowait(
+        mf, nghost, WarpX::do_single_precision_comms, Geom(lev).periodicity(),
+        WarpX::sync_nodal_points);
+    EvolveB(lev, PatchType::fine, a_dt, a_dt_type, FieldPushRegion::Interior);
+    ablastr::utils::communication::FillBoundary_finish(request);
+    EvolveB(lev, PatchType::fine, a_dt, a_dt_type, FieldPushRegion::Boundary);
+
+    // Allow execution of Python callback after B-field push
+    ExecutePythonCallback("afterBpush");
+}
+
+void
+WarpX::FillBoundaryBJAndEvolveEB (amrex::Real a_dt)
+{
+    WARPX_PROFILE("WarpX::FillBoundaryBJAndEvolveEB()");
+
+    // only level 0, with periodic boundaries (see the checks of warpx.do_fdtd_temporal_blocking)
+    int const lev = 0;
+
+    // E is updated in the first guard cell of each box, from B in the first two guard
+    // cells and J in the first guard cell: these are exchanged in a single batched call
+    amrex::Vector<amrex::MultiFab*> mf;
+    amrex::Vector<amrex::IntVect> nghost;
+    for (auto const& B : Bfield_fp[lev]) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            B->nGrowVect().allGE(2),
+            "Error: warpx.do_fdtd_temporal_blocking requires at least two guard cells for B");
+        mf.push_back(B.get());
+        nghost.push_back((safe_guard_cells) ? B->nGrowVect() : amrex::IntVect(2));
+    }
+    for (auto const& J : current_fp[lev]) {
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            J->nGrowVect().allGE(1),
+            "Error: warpx.do_fdtd_temporal_blocking requires at least one guard cell for J");
+        mf.push_back(J.get());
+        nghost.push_back(amrex::IntVect(1));
+    }
+    ablastr::utils::communication::FillBoundary(
+        mf, nghost, WarpX::do_single_precision_comms, Geom(lev).periodicity(),
+        WarpX::sync_nodal_points);
+
+    m_fdtd_solver_fp[lev]->EvolveEBBlocked(Efield_fp[lev], Bfield_fp[lev], current_fp[lev],
+                                           m_macroscopic_properties, lev, a_dt, 0.5_rt * a_dt);
+
+    // no-op with the periodic boundaries required by warpx.do_fdtd_temporal_blocking,
+    // kept for consistency with the default push
+    ApplyEfieldBoundary(lev, PatchType::fine);
+    ApplyBfieldBoundary(lev, PatchType::fine, DtType::SecondHalf);
+
+    // Allow execution of Python callbacks after the E-field and B-field pushes
+    ExecutePythonCallback("afterEpush");
+    ExecutePythonCallback("afterBpush");
+}
+
 void
 WarpX::EvolveF (amrex::Real a_dt, DtType a_dt_type)
 {
@@ -21,6 +21,7 @@
 #include <AMReX_MultiFab.H>
 
 #include <algorithm>
+#include <array>
 
 using namespace amrex;
 
@@ -44,7 +45,7 @@ Filter::ApplyStencil (MultiFab& dstmf, const MultiFab& srcmf, const int lev, int
 
     for (MFIter mfi(dstmf); mfi.isValid(); ++mfi)
     {
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
         {
             amrex::Gpu::synchronize();
         }
@@ -57,7 +58,7 @@ Filter::ApplyStencil (MultiFab& dstmf, const MultiFab& srcmf, const int lev, int
         // Apply filter
         DoFilter(tbx, src, dst, scomp, dcomp, ncomp);
 
-        if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+        if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
         {
             amrex::Gpu::synchronize();
             wt = static_cast<amrex::Real>(amrex::second()) - wt;
@@ -210,7 +211,7 @@ Filter::ApplyStencil (amrex::MultiFab& dstmf, const amrex::MultiFab& srcmf, cons
         FArrayBox tmpfab;
         for (MFIter mfi(dstmf,true); mfi.isValid(); ++mfi){
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
             }
@@ -229,7 +230,7 @@ Filter::ApplyStencil (amrex::MultiFab& dstmf, const amrex::MultiFab& srcmf, cons
             // Apply filter
             DoFilter(tbx, tmpfab.array(), dstfab.array(), 0, dcomp, ncomp);
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
                 wt = static_cast<amrex::Real>(amrex::second()) - wt;
@@ -265,61 +266,94 @@ Filter::ApplyStencil (amrex::FArrayBox& dstfab, const amrex::FArrayBox& srcfab,
     DoFilter(tbx, tmpfab.array(), dstfab.array(), 0, dcomp, ncomp);
 }
 
+namespace {
+    /* \brief Apply the 1D symmetric stencil s of length len (with s[0] halved,
+     * as for the full stencil) along direction dir, on box bx:
+     * dst(i) = sum_l s[l]*(src(i-l)+src(i+l)).
+     * The loops on the stencil are inside the loops on j and k, so that
+     * each row of src is reused from cache for all the stencil points.
+     */
+    void filter_1d (const Box& bx,
+                    Array4<Real const> const& src, int scomp,
+                    Array4<Real      > const& dst, int dcomp,
+                    Real const* AMREX_RESTRICT s, int len, int dir)
+    {
+        const auto lo = amrex::lbound(bx);
+        const auto hi = amrex::ubound(bx);
+        const int di = (dir == 0) ? 1 : 0;
+        const int dj = (dir == 1) ? 1 : 0;
+        const int dk = (dir == 2) ? 1 : 0;
+        for     (int k = lo.z; k <= hi.z; ++k) {
+            for (int j = lo.y; j <= hi.y; ++j) {
+                AMREX_PRAGMA_SIMD
+                for (int i = lo.x; i <= hi.x; ++i) {
+                    dst(i,j,k,dcomp) = 2._rt*s[0]*src(i,j,k,scomp);
+                }
+                for (int l = 1; l < len; ++l) {
+                    const Real sl = s[l];
+                    AMREX_PRAGMA_SIMD
+                    for (int i = lo.x; i <= hi.x; ++i) {
+                        dst(i,j,k,dcomp) += sl*(src(i-l*di,j-l*dj,k-l*dk,scomp)
+                                               +src(i+l*di,j+l*dj,k+l*dk,scomp));
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* \brief Apply stencil (CPU version).
+ * The stencil is the tensor product of the 1D stencils along each direction,
+ * so it is applied as a sequence of 1D passes (one per direction with a
+ * stencil longer than 1 point) on the tile, through two temporary buffers
+ * that stay in cache for tile-sized boxes. This costs 2*(slen.x+slen.y+slen.z)
+ * operations per point instead of 8*slen.x*slen.y*slen.z.
+ * tmp must be defined on tbx grown by slen-1 in each direction.
+ */
 void Filter::DoFilter (const Box& tbx,
                        Array4<Real const> const& tmp,
                        Array4<Real      > const& dst,
                        int scomp, int dcomp, int ncomp)
 {
-    const auto lo = amrex::lbound(tbx);
-    const auto hi = amrex::ubound(tbx);
-    // tmp and dst are of type Array4 (Fortran ordering)
-    AMREX_D_TERM(
-    amrex::Real const* AMREX_RESTRICT s0 = m_stencil_0.data();,
-    amrex::Real const* AMREX_RESTRICT s1 = m_stencil_1.data();,
-    amrex::Real const* AMREX_RESTRICT s2 = m_stencil_2.data();
-    )
-    for (int n = 0; n < ncomp; ++n) {
-        // Set dst value to 0.
-        for         (int k = lo.z; k <= hi.z; ++k) {
-            for     (int j = lo.y; j <= hi.y; ++j) {
-                for (int i = lo.x; i <= hi.x; ++i) {
-                    dst(i,j,k,dcomp+n) = 0.0;
-                }
-            }
+    const std::array<Real const*,3> stencils = {m_stencil_0.data(), m_stencil_1.data(), m_stencil_2.data()};
+    const std::array<int,3> lengths = {slen.x, slen.y, slen.z};
+
+    // Directions in which the stencil is not the identity
+    std::array<int,3> dirs = {0, 0, 0};
+    int ndirs = 0;
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+        if (lengths[dir] > 1) { dirs[ndirs++] = dir; }
+    }
+    if (ndirs == 0) {
+        // Identity filter: a single pass of length 1 copies tmp into dst
+        dirs[0] = 0;
+        ndirs = 1;
+    }
+
+    // Box of each pass: tbx, grown along the directions that remain to be filtered
+    std::array<Box,3> boxes;
+    for (int p = 0; p < ndirs; ++p) {
+        boxes[p] = tbx;
+        for (int q = p+1; q < ndirs; ++q) {
+            boxes[p].grow(dirs[q], lengths[dirs[q]]-1);
         }
-        // 3 nested loop on 3D stencil
-        for         (int i2=0; i2 < slen.z; ++i2){
-            for     (int i1=0; i1 < slen.y; ++i1){
-                for (int i0=0; i0 < slen.x; ++i0){
-                    const Real sss = AMREX_D_TERM(s0[i0], *s1[i1], *s2[i2]);
-                    // 3 nested loop on 3D array
-                    for         (int k = lo.z; k <= hi.z; ++k) {
-                        for     (int j = lo.y; j <= hi.y; ++j) {
-                            AMREX_PRAGMA_SIMD
-                            for (int i = lo.x; i <= hi.x; ++i) {
-#if AMREX_SPACEDIM == 3
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-i0,j-i1,k-i2,scomp+n)
-                                                          +tmp(i+i0,j-i1,k-i2,scomp+n)
-                                                          +tmp(i-i0,j+i1,k-i2,scomp+n)
-                                                          +tmp(i+i0,j+i1,k-i2,scomp+n)
-                                                          +tmp(i-i0,j-i1,k+i2,scomp+n)
-                                                          +tmp(i+i0,j-i1,k+i2,scomp+n)
-                                                          +tmp(i-i0,j+i1,k+i2,scomp+n)
-                                                          +tmp(i+i0,j+i1,k+i2,scomp+n));
-#elif AMREX_SPACEDIM == 2
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-i0,j-i1,k,scomp+n)
-                                                          +tmp(i+i0,j-i1,k,scomp+n)
-                                                          +tmp(i-i0,j+i1,k,scomp+n)
-                                                          +tmp(i+i0,j+i1,k,scomp+n));
-#elif AMREX_SPACEDIM == 1
-                                dst(i,j,k,dcomp+n) += sss*(tmp(i-i0,j,k,scomp+n)
-                                                          +tmp(i+i0,j,k,scomp+n));
-#endif
-                            }
-                        }
-                    }
-                }
-            }
+    }
+
+    // Intermediate results, one component at a time
+    FArrayBox buf[2];
+    for (int p = 0; p < ndirs-1; ++p) {
+        buf[p%2].resize(boxes[p], 1);
+    }
+
+    for (int n = 0; n < ncomp; ++n) {
+        for (int p = 0; p < ndirs; ++p) {
+            const int dir = dirs[p];
+            const bool first = (p == 0);
+            const bool last = (p == ndirs-1);
+            filter_1d(boxes[p],
+                      first ? tmp : buf[(p+1)%2].const_array(), first ? scomp+n : 0,
+                      last ? dst : buf[p%2].array(), last ? dcomp+n : 0,
+                      stencils[dir], lengths[dir], dir);
         }
     }
 }
@@ -393,6 +393,23 @@ WarpX::PrintMainPICparameters ()
     if (fft_do_time_averaging){
       amrex::Print()<<"                      | - time-averaged is ON \n";
     }
+#if !defined(WARPX_DIM_RZ)
+    if (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD){
+      // Memory of the coefficients of the J-linear-in-time equations, over all levels and ranks
+      amrex::Long coef_bytes = 0;
+      for (int lev = 0; lev <= finest_level; ++lev) {
+        if (spectral_solver_fp[lev]) { coef_bytes += spectral_solver_fp[lev]->JLinearInTimeCoefficientsBytes(); }
+        if (spectral_solver_cp[lev]) { coef_bytes += spectral_solver_cp[lev]->JLinearInTimeCoefficientsBytes(); }
+      }
+      amrex::ParallelDescriptor::ReduceLongSum(coef_bytes);
+      if (coef_bytes > 0){
+        amrex::Print() << "                      | - coefficients: "
+                       << static_cast<double>(coef_bytes) / (1024. * 1024.) << " MiB, "
+                       << ((fft_on_the_fly_coefficients) ? "computed on the fly (not stored)" : "stored")
+                       << "\n";
+      }
+    }
+#endif
   #endif // WARPX_USE_FFT
 
   if (grid_type == GridType::Collocated){
@@ -664,18 +681,20 @@ WarpX::InitFromScratch ()
         m_implicit_solver->GetParticleSolverParams( max_particle_its_in_implicit_scheme,
                                                     particle_tol_in_implicit_scheme );
 
-        // Add space to save the positions and velocities at the start of the time steps
+        // Add space to save the positions and velocities at the start of the time steps.
+        // They are set at the start of each step and only used before the particles are
+        // redistributed, so they are not communicated.
         for (auto const& pc : *mypc) {
 #if (AMREX_SPACEDIM >= 2)
-            pc->AddRealComp("x_n");
+            pc->AddRealComp("x_n", false);
 #endif
 #if defined(WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-            pc->AddRealComp("y_n");
+            pc->AddRealComp("y_n", false);
 #endif
-            pc->AddRealComp("z_n");
-            pc->AddRealComp("ux_n");
-            pc->AddRealComp("uy_n");
-            pc->AddRealComp("uz_n");
+            pc->AddRealComp("z_n", false);
+            pc->AddRealComp("ux_n", false);
+            pc->AddRealComp("uy_n", false);
+            pc->AddRealComp("uz_n", false);
         }
 
     }
@@ -1041,6 +1060,11 @@ WarpX::InitLevelData (int lev, Real /*time*/)
             WarpX::setLoadBalanceEfficiency(lev, -1);
         }
     }
+    if (particle_costs[lev]) {
+        for (const auto& i : particle_costs[lev]->IndexArray()) {
+            (*particle_costs[lev])[i] = 0.0;
+        }
+    }
 }
 
 void
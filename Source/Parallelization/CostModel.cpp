@@ -0,0 +1,165 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "CostModel.H"
+
+#include "Utils/TextMsg.H"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace
+{
+    /** Solve the dense n x n system a x = b (row-major a) by Gaussian elimination
+     *  with partial pivoting; a and b are overwritten. Returns false if a is singular. */
+    bool
+    SolveDense (std::vector<double>& a, std::vector<double>& b, std::vector<double>& x, int n)
+    {
+        for (int k = 0; k < n; ++k) {
+            int p = k;
+            for (int i = k+1; i < n; ++i) {
+                if (std::abs(a[i*n+k]) > std::abs(a[p*n+k])) { p = i; }
+            }
+            if (a[p*n+k] == 0.) { return false; }
+            if (p != k) {
+                for (int j = 0; j < n; ++j) { std::swap(a[k*n+j], a[p*n+j]); }
+                std::swap(b[k], b[p]);
+            }
+            for (int i = k+1; i < n; ++i) {
+                const double f = a[i*n+k]/a[k*n+k];
+                for (int j = k; j < n; ++j) { a[i*n+j] -= f*a[k*n+j]; }
+                b[i] -= f*b[k];
+            }
+        }
+        x.assign(n, 0.);
+        for (int i = n-1; i >= 0; --i) {
+            double s = b[i];
+            for (int j = i+1; j < n; ++j) { s -= a[i*n+j]*x[j]; }
+            x[i] = s/a[i*n+i];
+        }
+        return true;
+    }
+}
+
+CostModel::CostModel (std::vector<std::string> feature_names, int history)
+    : m_feature_names{std::move(feature_names)}, m_history{history}
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_history > 0,
+        "algo.costs_model_history must be positive");
+    m_coefficients.assign(m_feature_names.size(), amrex::Real(0));
+}
+
+void
+CostModel::AddSample (std::vector<amrex::Real> const& features,
+                      std::vector<amrex::Real> const& costs)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        features.size() == costs.size()*m_feature_names.size(),
+        "CostModel::AddSample: inconsistent number of features and costs");
+    m_samples.push_back(Sample{features, costs});
+    while (static_cast<int>(m_samples.size()) > m_history) { m_samples.pop_front(); }
+}
+
+bool
+CostModel::Fit ()
+{
+    const int nf = nFeatures();
+
+    // Scale each feature by its maximum, for the conditioning of the normal equations;
+    // features that are zero for all boxes are left out of the fit
+    std::vector<double> scale(nf, 0.);
+    int nrows = 0;
+    double cost_sum = 0.;
+    for (auto const& s : m_samples) {
+        for (std::size_t ib = 0; ib < s.costs.size(); ++ib) {
+            for (int j = 0; j < nf; ++j) {
+                scale[j] = std::max(scale[j], std::abs(double(s.features[ib*nf+j])));
+            }
+            cost_sum += s.costs[ib];
+            ++nrows;
+        }
+    }
+    std::vector<bool> active(nf);
+    int nactive = 0;
+    for (int j = 0; j < nf; ++j) {
+        active[j] = scale[j] > 0.;
+        if (active[j]) { ++nactive; }
+    }
+    // Require more boxes than coefficients, otherwise keep the previous fit
+    if (nactive == 0 || nrows <= nactive || cost_sum <= 0.) { return m_fitted; }
+
+    // Least squares with non-negative coefficients: solve the normal equations,
+    // then drop the most negative coefficient and solve again until all are non-negative
+    std::vector<double> w(nf, 0.);
+    while (nactive > 0) {
+        std::vector<int> cols;
+        for (int j = 0; j < nf; ++j) { if (active[j]) { cols.push_back(j); } }
+        const int n = static_cast<int>(cols.size());
+        std::vector<double> ata(n*n, 0.), atb(n, 0.), x;
+        for (auto const& s : m_samples) {
+            for (std::size_t ib = 0; ib < s.costs.size(); ++ib) {
+                auto const* f = &s.features[ib*nf];
+                for (int a = 0; a < n; ++a) {
+                    const double fa = f[cols[a]]/scale[cols[a]];
+                    atb[a] += fa*s.costs[ib];
+                    for (int b = 0; b < n; ++b) {
+                        ata[a*n+b] += fa*f[cols[b]]/scale[cols[b]];
+                    }
+                }
+            }
+        }
+        // small Tikhonov regularization, for features that are collinear
+        // (e.g. cells and overhead when all the boxes have the same size)
+        double trace = 0.;
+        for (int a = 0; a < n; ++a) { trace += ata[a*n+a]; }
+        for (int a = 0; a < n; ++a) { ata[a*n+a] += 1.e-10*trace/n; }
+
+        if (!SolveDense(ata, atb, x, n)) { return m_fitted; }
+
+        int most_negative = -1;
+        for (int a = 0; a < n; ++a) {
+            if (x[a] < 0. && (most_negative < 0 || x[a] < x[most_negative])) { most_negative = a; }
+        }
+        if (most_negative < 0) {
+            w.assign(nf, 0.);
+            for (int a = 0; a < n; ++a) { w[cols[a]] = x[a]/scale[cols[a]]; }
+            break;
+        }
+        active[cols[most_negative]] = false;
+        --nactive;
+    }
+    if (nactive == 0) { return m_fitted; }
+
+    for (int j = 0; j < nf; ++j) { m_coefficients[j] = static_cast<amrex::Real>(w[j]); }
+    m_fitted = true;
+    m_n_fit_boxes = nrows;
+
+    // Quality of the fit
+    const double cost_mean = cost_sum/nrows;
+    double ss_res = 0., ss_tot = 0.;
+    for (auto const& s : m_samples) {
+        for (std::size_t ib = 0; ib < s.costs.size(); ++ib) {
+            const double r = s.costs[ib] - Predict(&s.features[ib*nf]);
+            const double d = s.costs[ib] - cost_mean;
+            ss_res += r*r;
+            ss_tot += d*d;
+        }
+    }
+    m_r_squared = static_cast<amrex::Real>(
+        (ss_tot > 0.) ? 1. - ss_res/ss_tot : ((ss_res > 0.) ? 0. : 1.));
+    m_relative_residual = static_cast<amrex::Real>(std::sqrt(ss_res/nrows)/cost_mean);
+    return true;
+}
+
+amrex::Real
+CostModel::Predict (amrex::Real const* features) const
+{
+    amrex::Real cost = 0;
+    for (int j = 0; j < nFeatures(); ++j) { cost += m_coefficients[j]*features[j]; }
+    return cost;
+}
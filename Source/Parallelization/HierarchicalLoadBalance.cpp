@@ -0,0 +1,430 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "HierarchicalLoadBalance.H"
+
+#include "Utils/TextMsg.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_IntVect.H>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <numeric>
+#include <utility>
+
+namespace
+{
+    /** Mean over max of the loads */
+    amrex::Real
+    Efficiency (std::vector<double> const& loads)
+    {
+        if (loads.empty()) { return amrex::Real(1); }
+        double sum = 0.;
+        double max = 0.;
+        for (auto const l : loads) {
+            sum += l;
+            max = std::max(max, l);
+        }
+        return static_cast<amrex::Real>(
+            (max > 0.) ? sum/static_cast<double>(loads.size())/max : 1.);
+    }
+
+    /** Split the boxes, ordered along the space-filling curve, into contiguous segments
+     *  whose costs are proportional to the capacities; returns the segment of each box */
+    std::vector<int>
+    PartitionAlongCurve (std::vector<int> const& boxes, std::vector<amrex::Real> const& costs,
+                         std::vector<double> const& capacities)
+    {
+        const int nparts = static_cast<int>(capacities.size());
+        double total_cost = 0.;
+        for (auto const b : boxes) { total_cost += costs[b]; }
+        const double total_capacity = std::accumulate(capacities.begin(), capacities.end(), 0.);
+
+        std::vector<int> part(boxes.size());
+        int k = 0;
+        double cum = 0.;
+        double end = total_cost*capacities[0]/total_capacity;
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            const double c = costs[boxes[i]];
+            // move on to the next segment once the middle of the box is past its end
+            while (k < nparts-1 && cum + 0.5*c > end) {
+                ++k;
+                end += total_cost*capacities[k]/total_capacity;
+            }
+            part[i] = k;
+            cum += c;
+        }
+        return part;
+    }
+
+    /** Knapsack: each box, by decreasing cost, goes to the least loaded rank
+     *  that has less than nmax boxes; returns the rank of each box */
+    std::vector<int>
+    Knapsack (std::vector<int> const& boxes, std::vector<amrex::Real> const& costs,
+              int nranks, int nmax)
+    {
+        std::vector<std::size_t> order(boxes.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+            return costs[boxes[a]] > costs[boxes[b]];
+        });
+
+        std::vector<double> loads(nranks, 0.);
+        std::vector<int> counts(nranks, 0);
+        std::vector<int> rank(boxes.size());
+        for (auto const i : order) {
+            int r_min = -1;
+            for (int r = 0; r < nranks; ++r) {
+                if (counts[r] >= nmax) { continue; }
+                if (r_min < 0 || loads[r] < loads[r_min]) { r_min = r; }
+            }
+            if (r_min < 0) {
+                r_min = static_cast<int>(std::min_element(loads.begin(), loads.end()) - loads.begin());
+            }
+            rank[i] = r_min;
+            loads[r_min] += costs[boxes[i]];
+            ++counts[r_min];
+        }
+        return rank;
+    }
+
+    using Center = std::array<double, AMREX_SPACEDIM>;
+
+    /** Recursive coordinate bisection: split the boxes across the direction in which
+     *  their centers are the most spread, with costs proportional to the capacities of
+     *  the two halves of the parts, until there is one part; sets the part of each box */
+    void
+    Bisect (std::vector<int> boxes, int first_part, int nparts,
+            std::vector<double> const& capacities, std::vector<Center> const& centers,
+            std::vector<amrex::Real> const& costs, std::vector<int>& part_of_box)
+    {
+        if (nparts == 1 || boxes.empty()) {
+            for (auto const b : boxes) { part_of_box[b] = first_part; }
+            return;
+        }
+        const int nleft = nparts/2;
+        double capacity_left = 0., capacity_total = 0.;
+        for (int k = first_part; k < first_part + nparts; ++k) {
+            capacity_total += capacities[k];
+            if (k < first_part + nleft) { capacity_left += capacities[k]; }
+        }
+
+        int dir = 0;
+        double max_extent = -1.;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            double lo = centers[boxes[0]][idim], hi = lo;
+            for (auto const b : boxes) {
+                lo = std::min(lo, centers[b][idim]);
+                hi = std::max(hi, centers[b][idim]);
+            }
+            if (hi - lo > max_extent) { max_extent = hi - lo; dir = idim; }
+        }
+        std::stable_sort(boxes.begin(), boxes.end(), [&](int a, int b) {
+            return centers[a][dir] < centers[b][dir];
+        });
+
+        double total_cost = 0.;
+        for (auto const b : boxes) { total_cost += costs[b]; }
+        const double target = (capacity_total > 0.) ? total_cost*capacity_left/capacity_total : 0.;
+        std::size_t cut = 0;
+        double cum = 0.;
+        while (cut < boxes.size() && cum + 0.5*costs[boxes[cut]] <= target) {
+            cum += costs[boxes[cut]];
+            ++cut;
+        }
+
+        Bisect(std::vector<int>(boxes.begin(), boxes.begin() + cut), first_part, nleft,
+               capacities, centers, costs, part_of_box);
+        Bisect(std::vector<int>(boxes.begin() + cut, boxes.end()), first_part + nleft, nparts - nleft,
+               capacities, centers, costs, part_of_box);
+    }
+
+    /** Guard cells exchanged between different parts */
+    double
+    CutVolume (std::vector<warpx::load_balance::HaloEdge> const& edges, std::vector<int> const& part)
+    {
+        double volume = 0.;
+        for (auto const& e : edges) {
+            if (part[e.a] != part[e.b]) { volume += e.volume; }
+        }
+        return volume;
+    }
+}
+
+namespace warpx::load_balance
+{
+
+std::vector<std::uint64_t>
+SpaceFillingCurveKeys (amrex::BoxArray const& ba)
+{
+    constexpr int nbits = 64/AMREX_SPACEDIM;
+    const amrex::IntVect lo = ba.minimalBox().smallEnd();
+
+    std::vector<std::uint64_t> keys(ba.size(), 0);
+    for (int i = 0; i < static_cast<int>(ba.size()); ++i) {
+        const amrex::IntVect p = ba[i].smallEnd() - lo;
+        std::uint64_t key = 0;
+        for (int bit = 0; bit < nbits; ++bit) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                const auto b = (static_cast<std::uint64_t>(p[idim]) >> bit) & std::uint64_t(1);
+                key |= b << (bit*AMREX_SPACEDIM + idim);
+            }
+        }
+        keys[i] = key;
+    }
+    return keys;
+}
+
+HierarchicalDistribution
+makeHierarchical (std::vector<amrex::Real> const& costs,
+                  std::vector<std::uint64_t> const& sfc_keys,
+                  std::vector<int> const& current_pmap,
+                  std::vector<int> const& node_of_rank,
+                  bool use_sfc,
+                  amrex::Real knapsack_factor,
+                  amrex::Real efficiency_ratio_threshold)
+{
+    const int nboxes = static_cast<int>(costs.size());
+    const int nranks = static_cast<int>(node_of_rank.size());
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        static_cast<int>(sfc_keys.size()) == nboxes && static_cast<int>(current_pmap.size()) == nboxes,
+        "makeHierarchical: inconsistent number of boxes");
+
+    const int nnodes = *std::max_element(node_of_rank.begin(), node_of_rank.end()) + 1;
+    std::vector<std::vector<int>> ranks_of_node(nnodes);
+    for (int r = 0; r < nranks; ++r) { ranks_of_node[node_of_rank[r]].push_back(r); }
+    std::vector<double> node_capacity(nnodes);
+    for (int k = 0; k < nnodes; ++k) {
+        node_capacity[k] = static_cast<double>(ranks_of_node[k].size());
+    }
+
+    // boxes ordered along the space-filling curve
+    std::vector<int> order(nboxes);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return sfc_keys[a] < sfc_keys[b];
+    });
+
+    HierarchicalDistribution result;
+
+    // Level 1: distribution of the boxes across the nodes
+    std::vector<int> current_node(nboxes);
+    for (int b = 0; b < nboxes; ++b) { current_node[b] = node_of_rank[current_pmap[b]]; }
+
+    std::vector<int> proposed_node(nboxes);
+    const std::vector<int> part = PartitionAlongCurve(order, costs, node_capacity);
+    for (int i = 0; i < nboxes; ++i) { proposed_node[order[i]] = part[i]; }
+
+    const auto NodeEfficiency = [&](std::vector<int> const& node) {
+        std::vector<double> loads(nnodes, 0.);
+        for (int b = 0; b < nboxes; ++b) { loads[node[b]] += costs[b]; }
+        for (int k = 0; k < nnodes; ++k) {
+            if (node_capacity[k] > 0.) { loads[k] /= node_capacity[k]; }
+        }
+        return Efficiency(loads);
+    };
+    result.current_node_efficiency = NodeEfficiency(current_node);
+    result.proposed_node_efficiency = NodeEfficiency(proposed_node);
+    result.rebalance_nodes = (efficiency_ratio_threshold > 0.)
+        && (result.proposed_node_efficiency > efficiency_ratio_threshold*result.current_node_efficiency);
+    std::vector<int> const& node_of_box = (result.rebalance_nodes) ? proposed_node : current_node;
+
+    // Level 2: distribution of the boxes of each node among its ranks
+    std::vector<std::vector<int>> boxes_of_node(nnodes);
+    for (auto const b : order) { boxes_of_node[node_of_box[b]].push_back(b); }
+
+    result.pmap = current_pmap;
+    for (int k = 0; k < nnodes; ++k)
+    {
+        auto const& boxes = boxes_of_node[k];
+        auto const& ranks = ranks_of_node[k];
+        const int nr = static_cast<int>(ranks.size());
+        if (boxes.empty()) { continue; }
+
+        const int nmax = static_cast<int>(std::ceil(
+            static_cast<double>(boxes.size())/nr*knapsack_factor));
+        const std::vector<int> local_rank = (use_sfc)
+            ? PartitionAlongCurve(boxes, costs, std::vector<double>(nr, 1.))
+            : Knapsack(boxes, costs, nr, nmax);
+
+        // boxes coming from another node must be redistributed; otherwise, the
+        // boxes are redistributed only if this improves the efficiency of the node
+        bool adopt = false;
+        for (auto const b : boxes) {
+            if (current_node[b] != k) { adopt = true; }
+        }
+        if (!adopt && efficiency_ratio_threshold > 0.)
+        {
+            std::vector<double> current_loads(nranks, 0.);
+            std::vector<double> proposed_loads(nr, 0.);
+            for (std::size_t i = 0; i < boxes.size(); ++i) {
+                current_loads[current_pmap[boxes[i]]] += costs[boxes[i]];
+                proposed_loads[local_rank[i]] += costs[boxes[i]];
+            }
+            std::vector<double> current_node_loads(nr);
+            for (int j = 0; j < nr; ++j) { current_node_loads[j] = current_loads[ranks[j]]; }
+            adopt = Efficiency(proposed_loads) > efficiency_ratio_threshold*Efficiency(current_node_loads);
+        }
+        if (adopt)
+        {
+            for (std::size_t i = 0; i < boxes.size(); ++i) {
+                result.pmap[boxes[i]] = ranks[local_rank[i]];
+            }
+            ++result.n_rebalanced_nodes;
+        }
+    }
+
+    std::vector<double> current_loads(nranks, 0.);
+    std::vector<double> proposed_loads(nranks, 0.);
+    for (int b = 0; b < nboxes; ++b) {
+        current_loads[current_pmap[b]] += costs[b];
+        proposed_loads[result.pmap[b]] += costs[b];
+    }
+    result.current_efficiency = Efficiency(current_loads);
+    result.proposed_efficiency = Efficiency(proposed_loads);
+
+    return result;
+}
+
+std::vector<HaloEdge>
+HaloGraph (amrex::BoxArray const& ba, amrex::IntVect const& ng, amrex::Periodicity const& period)
+{
+    std::map<std::pair<int, int>, double> volume;
+    const auto shifts = period.shiftIntVect();
+    for (int i = 0; i < static_cast<int>(ba.size()); ++i)
+    {
+        const amrex::Box grown = amrex::grow(ba[i], ng);
+        for (auto const& shift : shifts)
+        {
+            for (auto const& [j, isect] : ba.intersections(amrex::shift(grown, shift)))
+            {
+                if (j == i) { continue; }
+                volume[std::minmax(i, j)] += isect.d_numPts();
+            }
+        }
+    }
+
+    std::vector<HaloEdge> edges;
+    edges.reserve(volume.size());
+    for (auto const& [key, v] : volume) { edges.push_back(HaloEdge{key.first, key.second, v}); }
+    return edges;
+}
+
+TopologyDistribution
+makeTopologyAware (std::vector<amrex::Real> const& costs,
+                   amrex::BoxArray const& ba,
+                   std::vector<HaloEdge> const& edges,
+                   std::vector<int> const& current_pmap,
+                   std::vector<int> const& node_of_rank,
+                   amrex::Real node_tolerance)
+{
+    const int nboxes = static_cast<int>(costs.size());
+    const int nranks = static_cast<int>(node_of_rank.size());
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        static_cast<int>(ba.size()) == nboxes && static_cast<int>(current_pmap.size()) == nboxes,
+        "makeTopologyAware: inconsistent number of boxes");
+
+    const int nnodes = *std::max_element(node_of_rank.begin(), node_of_rank.end()) + 1;
+    std::vector<std::vector<int>> ranks_of_node(nnodes);
+    for (int r = 0; r < nranks; ++r) { ranks_of_node[node_of_rank[r]].push_back(r); }
+    std::vector<double> node_capacity(nnodes);
+    for (int k = 0; k < nnodes; ++k) {
+        node_capacity[k] = static_cast<double>(ranks_of_node[k].size());
+    }
+
+    std::vector<Center> centers(nboxes);
+    for (int b = 0; b < nboxes; ++b) {
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            centers[b][idim] = 0.5*(ba[b].smallEnd(idim) + ba[b].bigEnd(idim));
+        }
+    }
+    std::vector<int> all_boxes(nboxes);
+    std::iota(all_boxes.begin(), all_boxes.end(), 0);
+
+    // Level 1: distribution of the boxes across the nodes
+    std::vector<int> node_of_box(nboxes, 0);
+    Bisect(all_boxes, 0, nnodes, node_capacity, centers, costs, node_of_box);
+
+    // Move the boxes at the boundaries of the nodes to the neighboring node with which
+    // they exchange most guard cells, if the cost of this node stays within its share
+    std::vector<std::vector<std::pair<int, double>>> neighbors(nboxes);
+    for (auto const& e : edges) {
+        neighbors[e.a].emplace_back(e.b, e.volume);
+        neighbors[e.b].emplace_back(e.a, e.volume);
+    }
+    double total_cost = 0.;
+    for (auto const c : costs) { total_cost += c; }
+    const double total_capacity = std::accumulate(node_capacity.begin(), node_capacity.end(), 0.);
+    std::vector<double> node_load(nnodes, 0.);
+    for (int b = 0; b < nboxes; ++b) { node_load[node_of_box[b]] += costs[b]; }
+    constexpr int npasses = 2;
+    for (int pass = 0; pass < npasses; ++pass)
+    {
+        for (int b = 0; b < nboxes; ++b)
+        {
+            std::map<int, double> exchanged;
+            for (auto const& [nb, v] : neighbors[b]) { exchanged[node_of_box[nb]] += v; }
+            const int from = node_of_box[b];
+            int best = from;
+            double best_gain = 0.;
+            for (auto const& [to, v] : exchanged) {
+                if (to == from) { continue; }
+                const double gain = v - exchanged[from];
+                const double share = total_cost*node_capacity[to]/total_capacity;
+                if (gain > best_gain && node_load[to] + costs[b] <= (1. + node_tolerance)*share) {
+                    best = to;
+                    best_gain = gain;
+                }
+            }
+            if (best != from) {
+                node_load[from] -= costs[b];
+                node_load[best] += costs[b];
+                node_of_box[b] = best;
+            }
+        }
+    }
+
+    // Level 2: distribution of the boxes of each node among its ranks
+    TopologyDistribution result;
+    result.pmap.assign(nboxes, 0);
+    std::vector<std::vector<int>> boxes_of_node(nnodes);
+    for (int b = 0; b < nboxes; ++b) { boxes_of_node[node_of_box[b]].push_back(b); }
+    std::vector<int> local_rank(nboxes, 0);
+    for (int k = 0; k < nnodes; ++k)
+    {
+        auto const& ranks = ranks_of_node[k];
+        const int nr = static_cast<int>(ranks.size());
+        Bisect(boxes_of_node[k], 0, nr, std::vector<double>(nr, 1.), centers, costs, local_rank);
+        for (auto const b : boxes_of_node[k]) { result.pmap[b] = ranks[local_rank[b]]; }
+    }
+
+    std::vector<double> current_loads(nranks, 0.);
+    std::vector<double> proposed_loads(nranks, 0.);
+    for (int b = 0; b < nboxes; ++b) {
+        current_loads[current_pmap[b]] += costs[b];
+        proposed_loads[result.pmap[b]] += costs[b];
+    }
+    result.current_efficiency = Efficiency(current_loads);
+    result.proposed_efficiency = Efficiency(proposed_loads);
+
+    std::vector<int> current_node(nboxes), proposed_node(nboxes);
+    for (int b = 0; b < nboxes; ++b) {
+        current_node[b] = node_of_rank[current_pmap[b]];
+        proposed_node[b] = node_of_rank[result.pmap[b]];
+    }
+    result.current_off_node_volume = CutVolume(edges, current_node);
+    result.proposed_off_node_volume = CutVolume(edges, proposed_node);
+    result.current_off_rank_volume = CutVolume(edges, current_pmap);
+    result.proposed_off_rank_volume = CutVolume(edges, result.pmap);
+
+    return result;
+}
+
+}
@@ -0,0 +1,52 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParallelTasks.H"
+
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ccse-mpi.H>
+
+#include <algorithm>
+
+namespace warpx::parallel_tasks
+{
+
+std::vector<int>
+RunConcurrently (std::vector<std::function<void()>> const& tasks)
+{
+    const int ntasks = static_cast<int>(tasks.size());
+    const int nprocs = amrex::ParallelContext::NProcsSub();
+    const int myproc = amrex::ParallelContext::MyProcSub();
+    const int ngroups = std::max(1, std::min(ntasks, nprocs));
+
+    // Group g is made of the ranks r such that r*ngroups/nprocs == g,
+    // the first of them being its I/O processor
+    const int mygroup = static_cast<int>(static_cast<long>(myproc)*ngroups/nprocs);
+    std::vector<int> group_root(ntasks);
+    for (int i = 0; i < ntasks; ++i) {
+        const long g = i % ngroups;
+        group_root[i] = static_cast<int>((g*nprocs + ngroups - 1)/ngroups);
+    }
+
+#ifdef AMREX_USE_MPI
+    MPI_Comm group_comm;
+    MPI_Comm_split(amrex::ParallelContext::CommunicatorSub(), mygroup, myproc, &group_comm);
+    amrex::ParallelContext::push(group_comm);
+#endif
+
+    for (int i = mygroup; i < ntasks; i += ngroups) {
+        tasks[i]();
+    }
+
+#ifdef AMREX_USE_MPI
+    amrex::ParallelContext::pop();
+    MPI_Comm_free(&group_comm);
+#endif
+
+    return group_root;
+}
+
+}
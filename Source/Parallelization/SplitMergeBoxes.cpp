@@ -0,0 +1,147 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "SplitMergeBoxes.H"
+
+#include "Utils/TextMsg.H"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+
+namespace
+{
+    using CornerKey = std::array<int, AMREX_SPACEDIM>;
+
+    CornerKey
+    ToKey (amrex::IntVect const& iv)
+    {
+        CornerKey key;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { key[idim] = iv[idim]; }
+        return key;
+    }
+
+    /** Split the box in halves (multiples of the blocking factor) along its longest
+     *  splittable direction until the cost of the pieces is at most split_cost */
+    void
+    SplitBox (amrex::Box const& b, amrex::Real cost, amrex::Real split_cost,
+              amrex::IntVect const& blocking_factor,
+              std::vector<amrex::Box>& boxes, std::vector<amrex::Real>& costs)
+    {
+        int dir = -1;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (b.length(idim) >= 2*blocking_factor[idim] &&
+                (dir < 0 || b.length(idim) > b.length(dir))) { dir = idim; }
+        }
+        if (cost <= split_cost || dir < 0) {
+            boxes.push_back(b);
+            costs.push_back(cost);
+            return;
+        }
+
+        const int lo_length = (b.length(dir)/blocking_factor[dir]/2)*blocking_factor[dir];
+        amrex::Box lo_box = b;
+        lo_box.setBig(dir, b.smallEnd(dir) + lo_length - 1);
+        amrex::Box hi_box = b;
+        hi_box.setSmall(dir, b.smallEnd(dir) + lo_length);
+        const amrex::Real lo_cost = cost*static_cast<amrex::Real>(lo_box.d_numPts()/b.d_numPts());
+
+        SplitBox(lo_box, lo_cost, split_cost, blocking_factor, boxes, costs);
+        SplitBox(hi_box, cost - lo_cost, split_cost, blocking_factor, boxes, costs);
+    }
+}
+
+namespace warpx::load_balance
+{
+
+SplitMergeResult
+SplitAndMergeBoxes (amrex::BoxArray const& ba,
+                    std::vector<amrex::Real> const& costs,
+                    amrex::Real split_cost,
+                    amrex::Real merge_cost,
+                    amrex::IntVect const& blocking_factor,
+                    amrex::IntVect const& max_grid_size)
+{
+    const int nboxes = static_cast<int>(ba.size());
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(static_cast<int>(costs.size()) == nboxes,
+        "SplitAndMergeBoxes: inconsistent number of boxes");
+
+    SplitMergeResult result;
+
+    // Merge: each cheap box, by increasing cost, with the cheapest of its neighbors
+    // that have the same extent in the other directions
+    std::map<CornerKey, int> box_starting_at;
+    std::map<CornerKey, int> box_ending_at;
+    for (int i = 0; i < nboxes; ++i) {
+        box_starting_at[ToKey(ba[i].smallEnd())] = i;
+        box_ending_at[ToKey(ba[i].bigEnd())] = i;
+    }
+
+    std::vector<int> order(nboxes);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return costs[a] < costs[b];
+    });
+
+    // partner of each box: -1 if not merged, the other box for the first box of a
+    // pair, nboxes for the second box of a pair
+    std::vector<int> partner(nboxes, -1);
+    for (auto const i : order)
+    {
+        if (costs[i] >= merge_cost) { break; }
+        if (partner[i] >= 0) { continue; }
+        const amrex::Box& bi = ba[i];
+
+        int best = -1;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            amrex::IntVect upper = bi.smallEnd();
+            upper[idim] = bi.bigEnd(idim) + 1;
+            amrex::IntVect lower = bi.bigEnd();
+            lower[idim] = bi.smallEnd(idim) - 1;
+            const auto up = box_starting_at.find(ToKey(upper));
+            const auto low = box_ending_at.find(ToKey(lower));
+            for (int j : {(up != box_starting_at.end()) ? up->second : -1,
+                          (low != box_ending_at.end()) ? low->second : -1})
+            {
+                if (j < 0 || partner[j] >= 0 || costs[i] + costs[j] >= merge_cost) { continue; }
+                amrex::Box u = bi;
+                u.minBox(ba[j]);
+                if (u.numPts() != bi.numPts() + ba[j].numPts()) { continue; }
+                if (u.length(idim) > max_grid_size[idim]) { continue; }
+                if (best < 0 || costs[j] < costs[best]) { best = j; }
+            }
+        }
+        if (best >= 0)
+        {
+            partner[std::min(i, best)] = std::max(i, best);
+            partner[std::max(i, best)] = nboxes;
+            ++result.n_merged;
+        }
+    }
+
+    // Split the expensive boxes, keeping the order of the original boxes
+    for (int i = 0; i < nboxes; ++i)
+    {
+        if (partner[i] == nboxes) { continue; }
+        if (partner[i] >= 0)
+        {
+            amrex::Box u = ba[i];
+            u.minBox(ba[partner[i]]);
+            result.boxes.push_back(u);
+            result.costs.push_back(costs[i] + costs[partner[i]]);
+            continue;
+        }
+        const std::size_t n_before = result.boxes.size();
+        SplitBox(ba[i], costs[i], split_cost, blocking_factor, result.boxes, result.costs);
+        if (result.boxes.size() > n_before + 1) { ++result.n_split; }
+    }
+
+    return result;
+}
+
+}
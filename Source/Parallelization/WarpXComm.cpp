@@ -700,16 +700,18 @@ WarpX::FillBoundaryE (const int lev, const PatchType patch_type, const amrex::In
 #endif
     }
 
-    // Fill guard cells in valid domain
+    // Fill guard cells in valid domain, exchanging the three components together
+    amrex::Vector<amrex::IntVect> nghost(3);
     for (int i = 0; i < 3; ++i)
     {
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             ng.allLE(mf[i]->nGrowVect()),
             "Error: in FillBoundaryE, requested more guard cells than allocated");
 
-        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
-        ablastr::utils::communication::FillBoundary(*mf[i], nghost, WarpX::do_single_precision_comms, period, nodal_sync);
+        nghost[i] = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
     }
+    ablastr::utils::communication::FillBoundary(
+        {mf[0], mf[1], mf[2]}, nghost, WarpX::do_single_precision_comms, period, nodal_sync);
 }
 
 void
@@ -757,16 +759,18 @@ WarpX::FillBoundaryB (const int lev, const PatchType patch_type, const amrex::In
 #endif
     }
 
-    // Fill guard cells in valid domain
+    // Fill guard cells in valid domain, exchanging the three components together
+    amrex::Vector<amrex::IntVect> nghost(3);
     for (int i = 0; i < 3; ++i)
     {
         WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
             ng.allLE(mf[i]->nGrowVect()),
             "Error: in FillBoundaryB, requested more guard cells than allocated");
 
-        const amrex::IntVect nghost = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
-        ablastr::utils::communication::FillBoundary(*mf[i], nghost, WarpX::do_single_precision_comms, period, nodal_sync);
+        nghost[i] = (safe_guard_cells) ? mf[i]->nGrowVect() : ng;
     }
+    ablastr::utils::communication::FillBoundary(
+        {mf[0], mf[1], mf[2]}, nghost, WarpX::do_single_precision_comms, period, nodal_sync);
 }
 
 void
@@ -794,9 +798,9 @@ WarpX::FillBoundaryE_avg (int lev, PatchType patch_type, IntVect ng)
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 ng.allLE(Efield_avg_fp[lev][0]->nGrowVect()),
                 "Error: in FillBoundaryE_avg, requested more guard cells than allocated");
-            ablastr::utils::communication::FillBoundary(*Efield_avg_fp[lev][0], ng, WarpX::do_single_precision_comms, period);
-            ablastr::utils::communication::FillBoundary(*Efield_avg_fp[lev][1], ng, WarpX::do_single_precision_comms, period);
-            ablastr::utils::communication::FillBoundary(*Efield_avg_fp[lev][2], ng, WarpX::do_single_precision_comms, period);
+            ablastr::utils::communication::FillBoundary(
+                {Efield_avg_fp[lev][0].get(), Efield_avg_fp[lev][1].get(), Efield_avg_fp[lev][2].get()},
+                amrex::Vector<amrex::IntVect>(3, ng), WarpX::do_single_precision_comms, period);
         }
     }
     else if (patch_type == PatchType::coarse)
@@ -815,9 +819,9 @@ WarpX::FillBoundaryE_avg (int lev, PatchType patch_type, IntVect ng)
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 ng.allLE(Efield_avg_cp[lev][0]->nGrowVect()),
                 "Error: in FillBoundaryE, requested more guard cells than allocated");
-            ablastr::utils::communication::FillBoundary(*Efield_avg_cp[lev][0], ng, WarpX::do_single_precision_comms, cperiod);
-            ablastr::utils::communication::FillBoundary(*Efield_avg_cp[lev][1], ng, WarpX::do_single_precision_comms, cperiod);
-            ablastr::utils::communication::FillBoundary(*Efield_avg_cp[lev][2], ng, WarpX::do_single_precision_comms, cperiod);
+            ablastr::utils::communication::FillBoundary(
+                {Efield_avg_cp[lev][0].get(), Efield_avg_cp[lev][1].get(), Efield_avg_cp[lev][2].get()},
+                amrex::Vector<amrex::IntVect>(3, ng), WarpX::do_single_precision_comms, cperiod);
         }
     }
 }
@@ -847,9 +851,9 @@ WarpX::FillBoundaryB_avg (int lev, PatchType patch_type, IntVect ng)
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 ng.allLE(Bfield_fp[lev][0]->nGrowVect()),
                 "Error: in FillBoundaryB, requested more guard cells than allocated");
-            ablastr::utils::communication::FillBoundary(*Bfield_avg_fp[lev][0], ng, WarpX::do_single_precision_comms, period);
-            ablastr::utils::communication::FillBoundary(*Bfield_avg_fp[lev][1], ng, WarpX::do_single_precision_comms, period);
-            ablastr::utils::communication::FillBoundary(*Bfield_avg_fp[lev][2], ng, WarpX::do_single_precision_comms, period);
+            ablastr::utils::communication::FillBoundary(
+                {Bfield_avg_fp[lev][0].get(), Bfield_avg_fp[lev][1].get(), Bfield_avg_fp[lev][2].get()},
+                amrex::Vector<amrex::IntVect>(3, ng), WarpX::do_single_precision_comms, period);
         }
     }
     else if (patch_type == PatchType::coarse)
@@ -867,9 +871,9 @@ WarpX::FillBoundaryB_avg (int lev, PatchType patch_type, IntVect ng)
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 ng.allLE(Bfield_avg_cp[lev][0]->nGrowVect()),
                 "Error: in FillBoundaryB_avg, requested more guard cells than allocated");
-            ablastr::utils::communication::FillBoundary(*Bfield_avg_cp[lev][0], ng, WarpX::do_single_precision_comms, cperiod);
-            ablastr::utils::communication::FillBoundary(*Bfield_avg_cp[lev][1], ng, WarpX::do_single_precision_comms, cperiod);
-            ablastr::utils::communication::FillBoundary(*Bfield_avg_cp[lev][2], ng, WarpX::do_single_precision_comms, cperiod);
+            ablastr::utils::communication::FillBoundary(
+                {Bfield_avg_cp[lev][0].get(), Bfield_avg_cp[lev][1].get(), Bfield_avg_cp[lev][2].get()},
+                amrex::Vector<amrex::IntVect>(3, ng), WarpX::do_single_precision_comms, cperiod);
         }
     }
 }
@@ -973,12 +977,12 @@ void
 WarpX::FillBoundaryAux (int lev, IntVect ng)
 {
     const amrex::Periodicity& period = Geom(lev).periodicity();
-    ablastr::utils::communication::FillBoundary(*Efield_aux[lev][0], ng, WarpX::do_single_precision_comms, period);
-    ablastr::utils::communication::FillBoundary(*Efield_aux[lev][1], ng, WarpX::do_single_precision_comms, period);
-    ablastr::utils::communication::FillBoundary(*Efield_aux[lev][2], ng, WarpX::do_single_precision_comms, period);
-    ablastr::utils::communication::FillBoundary(*Bfield_aux[lev][0], ng, WarpX::do_single_precision_comms, period);
-    ablastr::utils::communication::FillBoundary(*Bfield_aux[lev][1], ng, WarpX::do_single_precision_comms, period);
-    ablastr::utils::communication::FillBoundary(*Bfield_aux[lev][2], ng, WarpX::do_single_precision_comms, period);
+    // The six components are exchanged together: with a nodal or momentum-conserving
+    // gather, they share the same BoxArray and are sent in a single message per neighbor
+    ablastr::utils::communication::FillBoundary(
+        {Efield_aux[lev][0].get(), Efield_aux[lev][1].get(), Efield_aux[lev][2].get(),
+         Bfield_aux[lev][0].get(), Bfield_aux[lev][1].get(), Bfield_aux[lev][2].get()},
+        amrex::Vector<amrex::IntVect>(6, ng), WarpX::do_single_precision_comms, period);
 }
 
 void
@@ -1138,7 +1142,12 @@ WarpX::SyncCurrent (
             {
                 ApplyFilterJ(J_fp, lev, idim);
             }
-            SumBoundaryJ(J_fp, lev, idim, period);
+            // the sum may have been started during the deposition
+            // (see warpx.do_current_comm_overlap)
+            if (!SumBoundaryJ_finish(*J_fp[lev][idim]))
+            {
+                SumBoundaryJ(J_fp, lev, idim, period);
+            }
         }
     }
 }
@@ -1275,14 +1284,8 @@ void WarpX::ApplyFilterJ (
     }
 }
 
-void WarpX::SumBoundaryJ (
-    const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& current,
-    const int lev,
-    const int idim,
-    const amrex::Periodicity& period)
+amrex::IntVect WarpX::SumBoundaryJGuardCells (amrex::MultiFab const& J) const
 {
-    amrex::MultiFab& J = *current[lev][idim];
-
     const amrex::IntVect ng = J.nGrowVect();
     amrex::IntVect ng_depos_J = get_ng_depos_J();
 
@@ -1306,13 +1309,52 @@ void WarpX::SumBoundaryJ (
     }
 
     ng_depos_J.min(ng);
+    return ng_depos_J;
+}
 
-    const amrex::IntVect src_ngrow = ng_depos_J;
+void WarpX::SumBoundaryJ (
+    const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& current,
+    const int lev,
+    const int idim,
+    const amrex::Periodicity& period)
+{
+    amrex::MultiFab& J = *current[lev][idim];
+
+    const amrex::IntVect src_ngrow = SumBoundaryJGuardCells(J);
     const int icomp = 0;
     const int ncomp = J.nComp();
     WarpXSumGuardCells(J, period, src_ngrow, icomp, ncomp);
 }
 
+void WarpX::SumBoundaryJ_nowait (const int lev)
+{
+    WARPX_PROFILE("WarpX::SumBoundaryJ_nowait()");
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_current_sum_requests.empty(),
+        "SumBoundaryJ_nowait: the previous sum of the guard cells of J is not completed");
+
+    for (int idim = 0; idim < 3; ++idim)
+    {
+        amrex::MultiFab& J = *current_fp[lev][idim];
+        // same as WarpXSumGuardCells
+        m_current_sum_requests.push_back(ablastr::utils::communication::SumBoundary_nowait(
+            J, 0, J.nComp(), SumBoundaryJGuardCells(J), J.nGrowVect(),
+            WarpX::do_single_precision_comms, Geom(lev).periodicity()));
+    }
+}
+
+bool WarpX::SumBoundaryJ_finish (amrex::MultiFab& J)
+{
+    auto const it = std::find_if(m_current_sum_requests.begin(), m_current_sum_requests.end(),
+        [&J] (auto const& request) { return request.mf == &J; });
+    if (it == m_current_sum_requests.end()) { return false; }
+
+    WARPX_PROFILE("WarpX::SumBoundaryJ_finish()");
+    ablastr::utils::communication::SumBoundary_finish(*it);
+    m_current_sum_requests.erase(it);
+    return true;
+}
+
 void WarpX::SumBoundaryJ (
     const amrex::Vector<std::array<std::unique_ptr<amrex::MultiFab>,3>>& current,
     const int lev,
@@ -17,6 +17,10 @@
 #include "Particles/MultiParticleContainer.H"
 #include "Particles/ParticleBoundaryBuffer.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Parallelization/CostModel.H"
+#include "Parallelization/HierarchicalLoadBalance.H"
+#include "Parallelization/SplitMergeBoxes.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -27,6 +31,10 @@
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
+#ifdef AMREX_USE_EB
+#   include <AMReX_EBCellFlag.H>
+#   include <AMReX_EBFabFactory.H>
+#endif
 #include <AMReX_FabFactory.H>
 #include <AMReX_IArrayBox.H>
 #include <AMReX_IndexType.H>
@@ -37,25 +45,64 @@
 #include <AMReX_ParIter.H>
 #include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_Vector.H>
 #include <AMReX_iMultiFab.H>
 
+#ifdef AMREX_USE_MPI
+#   include <mpi.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 using namespace amrex;
 
+namespace
+{
+#ifdef AMREX_USE_EB
+    /** Number of cut cells of the embedded boundary in the box bx */
+    amrex::Long
+    countCutCells (amrex::EBCellFlagFab const& flag_fab, amrex::Box const& bx)
+    {
+        if (flag_fab.getType(bx) != amrex::FabType::singlevalued) { return 0; }
+
+        auto const& flag = flag_fab.const_array();
+        amrex::ReduceOps<amrex::ReduceOpSum> reduce_op;
+        amrex::ReduceData<amrex::Long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(bx, reduce_data,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+            {
+                return {flag(i,j,k).isSingleValued() ? amrex::Long(1) : amrex::Long(0)};
+            });
+        return amrex::get<0>(reduce_data.value());
+    }
+#endif
+}
+
 void
 WarpX::CheckLoadBalance (int step)
 {
     if (step > 0 && load_balance_intervals.contains(step+1))
     {
+        if (load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Model)
+        {
+            // replace the measured costs by the costs predicted for the next interval
+            UpdateCostModel(step);
+        }
+
         LoadBalance();
 
         // Reset the costs to 0
@@ -92,9 +139,30 @@ WarpX::LoadBalance ()
     {
         int doLoadBalance = false;
 
+        // With load_balance_particles_only, only the distribution mapping of the
+        // particles is balanced, with the costs of the particle work
+        const LayoutData<Real>& lb_costs =
+            (load_balance_particles_only) ? *particle_costs[lev] : *costs[lev];
+
         // Compute the new distribution mapping
         DistributionMapping newdm;
-        const amrex::Real nboxes = costs[lev]->size();
+
+        // Split the boxes that are too expensive to be balanced and merge the cheap ones;
+        // otherwise, only move the boxes
+        if (load_balance_regrid && lev == 0)
+        {
+            BoxArray newba;
+            amrex::Real regridEfficiency = 0.0;
+            if (MakeRegriddedBoxArray(lev, newba, newdm, regridEfficiency))
+            {
+                RemakeLevel(lev, t_new[lev], newba, newdm);
+                setLoadBalanceEfficiency(lev, regridEfficiency);
+                loadBalancedAnyLevel = true;
+                continue;
+            }
+        }
+
+        const amrex::Real nboxes = lb_costs.size();
         const amrex::Real nprocs = ParallelContext::NProcsSub();
         const int nmax = static_cast<int>(std::ceil(nboxes/nprocs*load_balance_knapsack_factor));
         // These store efficiency (meaning, the  average 'cost' over all ranks,
@@ -102,23 +170,36 @@ WarpX::LoadBalance ()
         amrex::Real currentEfficiency = 0.0;
         amrex::Real proposedEfficiency = 0.0;
 
-        newdm = (load_balance_with_sfc)
-            ? DistributionMapping::makeSFC(*costs[lev],
-                                           currentEfficiency, proposedEfficiency,
-                                           false,
-                                           ParallelDescriptor::IOProcessorNumber())
-            : DistributionMapping::makeKnapSack(*costs[lev],
-                                                currentEfficiency, proposedEfficiency,
-                                                nmax,
-                                                false,
-                                                ParallelDescriptor::IOProcessorNumber());
-        // As specified in the above calls to makeSFC and makeKnapSack, the new
-        // distribution mapping is NOT communicated to all ranks; the loadbalanced
-        // dm is up-to-date only on root, and we can decide whether to broadcast
-        if ((load_balance_efficiency_ratio_threshold > 0.0)
-            && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()))
+        if (load_balance_with_topology)
+        {
+            doLoadBalance = MakeTopologyAwareDistributionMapping(lev, lb_costs, newdm, proposedEfficiency);
+        }
+        else if (load_balance_hierarchical)
         {
-            doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+            // The efficiency threshold is applied separately across nodes and within
+            // each node; the new dm and the decision are up-to-date only on root
+            doLoadBalance = MakeHierarchicalDistributionMapping(lev, lb_costs, newdm, proposedEfficiency);
+        }
+        else
+        {
+            newdm = (load_balance_with_sfc)
+                ? DistributionMapping::makeSFC(lb_costs,
+                                               currentEfficiency, proposedEfficiency,
+                                               false,
+                                               ParallelDescriptor::IOProcessorNumber())
+                : DistributionMapping::makeKnapSack(lb_costs,
+                                                    currentEfficiency, proposedEfficiency,
+                                                    nmax,
+                                                    false,
+                                                    ParallelDescriptor::IOProcessorNumber());
+            // As specified in the above calls to makeSFC and makeKnapSack, the new
+            // distribution mapping is NOT communicated to all ranks; the loadbalanced
+            // dm is up-to-date only on root, and we can decide whether to broadcast
+            if ((load_balance_efficiency_ratio_threshold > 0.0)
+                && (ParallelDescriptor::MyProc() == ParallelDescriptor::IOProcessorNumber()))
+            {
+                doLoadBalance = (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency);
+            }
         }
 
         ParallelDescriptor::Bcast(&doLoadBalance, 1,
@@ -141,7 +222,19 @@ WarpX::LoadBalance ()
                 newdm = DistributionMapping(pmap);
             }
 
-            RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
+            if (load_balance_particles_only)
+            {
+                // The fields stay where they are; the particles are moved to their new
+                // owners by the redistribute below
+                for (int i = 0; i < mypc->nContainers(); ++i) {
+                    mypc->GetParticleContainer(i).SetParticleDistributionMap(lev, newdm);
+                }
+                particle_costs[lev] = std::make_unique<LayoutData<Real>>(boxArray(lev), newdm);
+            }
+            else
+            {
+                RemakeLevel(lev, t_new[lev], boxArray(lev), newdm);
+            }
 
             // Record the load balance efficiency
             setLoadBalanceEfficiency(lev, proposedEfficiency);
@@ -165,23 +258,333 @@ WarpX::LoadBalance ()
 #endif
 }
 
+std::vector<int> const&
+WarpX::NodeOfRank ()
+{
+    const int nprocs = ParallelDescriptor::NProcs();
+
+    // Node of each rank: consecutive groups of load_balance_ranks_per_node ranks,
+    // or the ranks that share memory
+    if (static_cast<int>(m_node_of_rank.size()) != nprocs)
+    {
+        m_node_of_rank.assign(nprocs, 0);
+        if (load_balance_ranks_per_node > 0)
+        {
+            for (int r = 0; r < nprocs; ++r) { m_node_of_rank[r] = r/load_balance_ranks_per_node; }
+        }
+        else
+        {
+#ifdef AMREX_USE_MPI
+            MPI_Comm node_comm;
+            BL_MPI_REQUIRE( MPI_Comm_split_type(ParallelDescriptor::Communicator(),
+                                                MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm) );
+            int leader = ParallelDescriptor::MyProc();
+            BL_MPI_REQUIRE( MPI_Bcast(&leader, 1, MPI_INT, 0, node_comm) );
+            BL_MPI_REQUIRE( MPI_Comm_free(&node_comm) );
+
+            std::vector<int> leaders(nprocs);
+            BL_MPI_REQUIRE( MPI_Allgather(&leader, 1, MPI_INT, leaders.data(), 1, MPI_INT,
+                                          ParallelDescriptor::Communicator()) );
+            std::map<int, int> node_of_leader;
+            for (int r = 0; r < nprocs; ++r)
+            {
+                if (node_of_leader.count(leaders[r]) == 0)
+                {
+                    const int node = static_cast<int>(node_of_leader.size());
+                    node_of_leader[leaders[r]] = node;
+                }
+                m_node_of_rank[r] = node_of_leader[leaders[r]];
+            }
+#endif
+        }
+    }
+    return m_node_of_rank;
+}
+
+bool
+WarpX::MakeHierarchicalDistributionMapping (int lev, LayoutData<Real> const& lb_costs,
+                                            DistributionMapping& newdm,
+                                            Real& proposedEfficiency)
+{
+    WARPX_PROFILE("WarpX::MakeHierarchicalDistributionMapping()");
+
+    const int root = ParallelDescriptor::IOProcessorNumber();
+
+    NodeOfRank();
+
+    // Gather the costs and the number of particles of the boxes on root
+    const int nboxes = lb_costs.size();
+    std::vector<Real> box_costs(nboxes, 0.0_rt);
+    std::vector<Real> box_particles(nboxes, 0.0_rt);
+    for (const auto& i : lb_costs.IndexArray())
+    {
+        box_costs[i] = lb_costs[i];
+    }
+    for (int i_s = 0; i_s < mypc->nSpecies(); ++i_s)
+    {
+        for (WarpXParIter pti(mypc->GetParticleContainer(i_s), lev); pti.isValid(); ++pti)
+        {
+            box_particles[pti.index()] += static_cast<Real>(pti.numParticles());
+        }
+    }
+    ParallelDescriptor::ReduceRealSum(box_costs.data(), nboxes, root);
+    ParallelDescriptor::ReduceRealSum(box_particles.data(), nboxes, root);
+
+    if (ParallelDescriptor::MyProc() != root) { return false; }
+
+    const BoxArray& ba = boxArray(lev);
+    const Vector<int>& current_pmap = lb_costs.DistributionMap().ProcessorMap();
+    const auto result = warpx::load_balance::makeHierarchical(
+        box_costs, warpx::load_balance::SpaceFillingCurveKeys(ba),
+        std::vector<int>(current_pmap.begin(), current_pmap.end()), m_node_of_rank,
+        load_balance_with_sfc, load_balance_knapsack_factor,
+        load_balance_efficiency_ratio_threshold);
+
+    // Data moved between nodes and within nodes by the new mapping
+    int boxes_between_nodes = 0;
+    int boxes_within_nodes = 0;
+    Long cells_between_nodes = 0;
+    Real particles_between_nodes = 0.0_rt;
+    for (int b = 0; b < nboxes; ++b)
+    {
+        if (result.pmap[b] == current_pmap[b]) { continue; }
+        if (m_node_of_rank[result.pmap[b]] != m_node_of_rank[current_pmap[b]])
+        {
+            ++boxes_between_nodes;
+            cells_between_nodes += ba[b].numPts();
+            particles_between_nodes += box_particles[b];
+        }
+        else
+        {
+            ++boxes_within_nodes;
+        }
+    }
+
+    if (verbose)
+    {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Hierarchical load balance on level " + std::to_string(lev)
+            + ": node efficiency " + std::to_string(result.current_node_efficiency)
+            + " -> " + std::to_string(result.proposed_node_efficiency)
+            + ((result.rebalance_nodes) ? " (adopted)" : " (not adopted)")
+            + ", " + std::to_string(result.n_rebalanced_nodes) + " node(s) rebalanced internally"
+            + ", efficiency " + std::to_string(result.current_efficiency)
+            + " -> " + std::to_string(result.proposed_efficiency)
+            + "; moved between nodes: " + std::to_string(boxes_between_nodes) + " boxes, "
+            + std::to_string(cells_between_nodes) + " cells, "
+            + std::to_string(static_cast<Long>(particles_between_nodes)) + " particles"
+            + "; moved within nodes: " + std::to_string(boxes_within_nodes) + " boxes");
+    }
+
+    newdm = DistributionMapping(Vector<int>(result.pmap.begin(), result.pmap.end()));
+    proposedEfficiency = result.proposed_efficiency;
+    return result.rebalance_nodes || (result.n_rebalanced_nodes > 0);
+}
+
+bool
+WarpX::MakeTopologyAwareDistributionMapping (int lev, LayoutData<Real> const& lb_costs,
+                                             DistributionMapping& newdm,
+                                             Real& proposedEfficiency)
+{
+    WARPX_PROFILE("WarpX::MakeTopologyAwareDistributionMapping()");
+
+    const int root = ParallelDescriptor::IOProcessorNumber();
+
+    NodeOfRank();
+
+    // Gather the costs of the boxes on root
+    const int nboxes = lb_costs.size();
+    std::vector<Real> box_costs(nboxes, 0.0_rt);
+    for (const auto& i : lb_costs.IndexArray())
+    {
+        box_costs[i] = lb_costs[i];
+    }
+    ParallelDescriptor::ReduceRealSum(box_costs.data(), nboxes, root);
+
+    if (ParallelDescriptor::MyProc() != root) { return false; }
+
+    // Guard cells exchanged by the field solver between neighboring boxes
+    // (large with the PSATD solver without periodic single box FFT)
+    const BoxArray& ba = boxArray(lev);
+    const auto edges = warpx::load_balance::HaloGraph(
+        ba, guard_cells.ng_FieldSolver, Geom(lev).periodicity());
+
+    const Vector<int>& current_pmap = lb_costs.DistributionMap().ProcessorMap();
+    const auto result = warpx::load_balance::makeTopologyAware(
+        box_costs, ba, edges,
+        std::vector<int>(current_pmap.begin(), current_pmap.end()), m_node_of_rank,
+        load_balance_topology_node_tolerance);
+
+    // Adopt the new mapping if it is more efficient, or if it exchanges fewer guard
+    // cells between nodes without being less efficient
+    const bool doLoadBalance = (load_balance_efficiency_ratio_threshold > 0.0)
+        && ((result.proposed_efficiency > load_balance_efficiency_ratio_threshold*result.current_efficiency)
+            || (result.proposed_off_node_volume < result.current_off_node_volume
+                && result.proposed_efficiency >= result.current_efficiency));
+
+    if (verbose)
+    {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Topology-aware load balance on level " + std::to_string(lev)
+            + ": efficiency " + std::to_string(result.current_efficiency)
+            + " -> " + std::to_string(result.proposed_efficiency)
+            + "; guard cells exchanged between nodes "
+            + std::to_string(static_cast<Long>(result.current_off_node_volume))
+            + " -> " + std::to_string(static_cast<Long>(result.proposed_off_node_volume))
+            + ", between ranks "
+            + std::to_string(static_cast<Long>(result.current_off_rank_volume))
+            + " -> " + std::to_string(static_cast<Long>(result.proposed_off_rank_volume))
+            + ((doLoadBalance) ? " (adopted)" : " (not adopted)"));
+    }
+
+    newdm = DistributionMapping(Vector<int>(result.pmap.begin(), result.pmap.end()));
+    proposedEfficiency = result.proposed_efficiency;
+    return doLoadBalance;
+}
+
+bool
+WarpX::MakeRegriddedBoxArray (int lev, BoxArray& newba, DistributionMapping& newdm,
+                              Real& proposedEfficiency)
+{
+    WARPX_PROFILE("WarpX::MakeRegriddedBoxArray()");
+
+    const int nprocs = ParallelDescriptor::NProcs();
+    const int root = ParallelDescriptor::IOProcessorNumber();
+
+    // Gather the costs of the boxes on root
+    const BoxArray& ba = boxArray(lev);
+    const int nboxes = costs[lev]->size();
+    std::vector<Real> box_costs(nboxes, 0.0_rt);
+    for (const auto& i : costs[lev]->IndexArray())
+    {
+        box_costs[i] = (*costs[lev])[i];
+    }
+    ParallelDescriptor::ReduceRealSum(box_costs.data(), nboxes, root);
+
+    // New boxes and their ranks, packed as (small end, big end, rank) on root
+    Vector<int> packed;
+    int doRegrid = false;
+    if (ParallelDescriptor::MyProc() == root)
+    {
+        Real total_cost = 0.0_rt;
+        for (const auto c : box_costs) { total_cost += c; }
+        const Real cost_per_rank = total_cost/nprocs;
+
+        const auto result = warpx::load_balance::SplitAndMergeBoxes(
+            ba, box_costs,
+            load_balance_regrid_split_fraction*cost_per_rank,
+            load_balance_regrid_merge_fraction*cost_per_rank,
+            blockingFactor(lev), maxGridSize(lev));
+
+        if (result.n_split > 0 || result.n_merged > 0)
+        {
+            const Vector<Real> new_costs(result.costs.begin(), result.costs.end());
+            const BoxArray proposed_ba(BoxList(Vector<Box>(result.boxes.begin(), result.boxes.end())));
+            const int nmax_new = static_cast<int>(std::ceil(
+                static_cast<Real>(new_costs.size())/nprocs*load_balance_knapsack_factor));
+            const DistributionMapping proposed_dm = (load_balance_with_sfc)
+                ? DistributionMapping::makeSFC(new_costs, proposed_ba, proposedEfficiency)
+                : DistributionMapping::makeKnapSack(new_costs, proposedEfficiency, nmax_new);
+
+            // Efficiency of the current mapping, and of the mapping that only moves the boxes
+            std::vector<Real> rank_costs(nprocs, 0.0_rt);
+            for (int i = 0; i < nboxes; ++i) { rank_costs[DistributionMap(lev)[i]] += box_costs[i]; }
+            const Real max_rank_cost = *std::max_element(rank_costs.begin(), rank_costs.end());
+            const Real currentEfficiency = (max_rank_cost > 0.0_rt) ? cost_per_rank/max_rank_cost : 1.0_rt;
+            Real movedEfficiency = 0.0_rt;
+            const Vector<Real> old_costs(box_costs.begin(), box_costs.end());
+            const int nmax = static_cast<int>(std::ceil(
+                static_cast<Real>(nboxes)/nprocs*load_balance_knapsack_factor));
+            if (load_balance_with_sfc) {
+                DistributionMapping::makeSFC(old_costs, ba, movedEfficiency);
+            } else {
+                DistributionMapping::makeKnapSack(old_costs, movedEfficiency, nmax);
+            }
+
+            // Regrid only if this does better than moving the boxes
+            doRegrid = (load_balance_efficiency_ratio_threshold > 0.0)
+                && (proposedEfficiency > load_balance_efficiency_ratio_threshold*currentEfficiency)
+                && (proposedEfficiency > movedEfficiency);
+
+            if (verbose)
+            {
+                amrex::Print() << Utils::TextMsg::Info(
+                    "Load balance regrid on level " + std::to_string(lev)
+                    + ": " + std::to_string(result.n_split) + " box(es) split, "
+                    + std::to_string(result.n_merged) + " pair(s) of boxes merged, "
+                    + std::to_string(nboxes) + " -> " + std::to_string(proposed_ba.size()) + " boxes"
+                    + "; efficiency " + std::to_string(currentEfficiency)
+                    + " -> " + std::to_string(proposedEfficiency)
+                    + " (moving the boxes only: " + std::to_string(movedEfficiency) + ")"
+                    + ((doRegrid) ? " (adopted)" : " (not adopted)"));
+            }
+
+            if (doRegrid)
+            {
+                for (int i = 0; i < static_cast<int>(proposed_ba.size()); ++i)
+                {
+                    const Box& b = proposed_ba[i];
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { packed.push_back(b.smallEnd(idim)); }
+                    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) { packed.push_back(b.bigEnd(idim)); }
+                    packed.push_back(proposed_dm[i]);
+                }
+            }
+        }
+    }
+
+    ParallelDescriptor::Bcast(&doRegrid, 1, root);
+    if (!doRegrid) { return false; }
+
+    int npacked = static_cast<int>(packed.size());
+    ParallelDescriptor::Bcast(&npacked, 1, root);
+    packed.resize(npacked);
+    ParallelDescriptor::Bcast(packed.data(), npacked, root);
+    ParallelDescriptor::Bcast(&proposedEfficiency, 1, root);
+
+    constexpr int nfields = 2*AMREX_SPACEDIM + 1;
+    const int nnew = npacked/nfields;
+    BoxList bl;
+    Vector<int> pmap(nnew);
+    for (int i = 0; i < nnew; ++i)
+    {
+        const int* p = &packed[i*nfields];
+        bl.push_back(Box(IntVect(p), IntVect(p + AMREX_SPACEDIM)));
+        pmap[i] = p[2*AMREX_SPACEDIM];
+    }
+    newba = BoxArray(std::move(bl));
+    newdm = DistributionMapping(std::move(pmap));
+    return true;
+}
+
 void
 WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const DistributionMapping& dm)
 {
 
+    // With algo.load_balance_regrid, the boxes of level 0 may change: the data is then
+    // copied from the valid cells of the old boxes to the new ones, guard cells included.
+    // The guard cells of the old boxes are not used as a source, since they overlap and
+    // may be outdated (e.g. for E and B at the start of a step)
+    bool const same_ba = (ba == boxArray(lev));
     const auto RemakeMultiFab = [&](auto& mf, const bool redistribute){
         if (mf == nullptr) { return; }
         const IntVect& ng = mf->nGrowVect();
         auto pmf = std::remove_reference_t<decltype(mf)>{};
-        AllocInitMultiFab(pmf, mf->boxArray(), dm, mf->nComp(), ng, lev, mf->tags()[0]);
-        if (redistribute) { pmf->Redistribute(*mf, 0, 0, mf->nComp(), ng); }
+        const BoxArray& mf_ba = (same_ba) ? mf->boxArray() : amrex::convert(ba, mf->ixType());
+        AllocInitMultiFab(pmf, mf_ba, dm, mf->nComp(), ng, lev, mf->tags()[0]);
+        if (redistribute) {
+            if (same_ba) {
+                pmf->Redistribute(*mf, 0, 0, mf->nComp(), ng);
+            } else {
+                pmf->ParallelCopy(*mf, 0, 0, mf->nComp(), IntVect(0), ng, Geom(lev).periodicity());
+            }
+        }
         mf = std::move(pmf);
     };
 
     bool const eb_enabled = EB::enabled();
-    if (ba == boxArray(lev))
+    if (same_ba || (lev == 0 && load_balance_regrid))
     {
-        if (ParallelDescriptor::NProcs() == 1) { return; }
+        if (same_ba && ParallelDescriptor::NProcs() == 1) { return; }
 
         // Fine patch
         for (int idim=0; idim < 3; ++idim)
@@ -388,6 +791,7 @@ WarpX::RemakeLevel (int lev, Real /*time*/, const BoxArray& ba, const Distributi
             }
         }
 
+        if (!same_ba) { SetBoxArray(lev, ba); }
         SetDistributionMap(lev, dm);
 
     } else
@@ -432,6 +836,213 @@ WarpX::ComputeCostsHeuristic (amrex::Vector<std::unique_ptr<amrex::LayoutData<am
     }
 }
 
+std::vector<amrex::Real>
+WarpX::ComputeCostModelFeatures (int lev) const
+{
+    const int nSpecies = mypc->nSpecies();
+    const int nf = m_cost_model->nFeatures();
+
+    // columns of the features, in the order of CostModel::FeatureNames()
+    const int i_overhead = 0;
+    const int i_cells = 1;
+    const int i_particles = 2;
+    const int i_pml = i_particles + nSpecies;
+    const int i_eb = i_pml + 1;
+    const int i_collisions = i_eb + 1;
+
+    const BoxArray& ba = costs[lev]->boxArray();
+    std::vector<amrex::Real> features(static_cast<std::size_t>(ba.size())*nf, 0.0_rt);
+
+    // Species loop
+    for (int i_s = 0; i_s < nSpecies; ++i_s)
+    {
+        auto & myspc = mypc->GetParticleContainer(i_s);
+
+        // Particle loop
+        for (WarpXParIter pti(myspc, lev); pti.isValid(); ++pti)
+        {
+            features[pti.index()*nf + i_particles + i_s] += static_cast<amrex::Real>(pti.numParticles());
+        }
+    }
+
+    // PML cells: the PML boxes are attached to the neighboring valid boxes
+    BoxList pml_region;
+    if (do_pml)
+    {
+        const Box& domain = Geom(lev).Domain();
+        Box outer = domain;
+        Box inner = domain;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            if (WarpX::field_boundary_lo[idim] == FieldBoundaryType::PML) {
+                outer.growLo(idim, pml_ncell);
+                inner.growLo(idim, -pml_ncell);
+            }
+            if (WarpX::field_boundary_hi[idim] == FieldBoundaryType::PML) {
+                outer.growHi(idim, pml_ncell);
+                inner.growHi(idim, -pml_ncell);
+            }
+        }
+        pml_region = (do_pml_in_domain) ? boxDiff(domain, inner) : boxDiff(outer, domain);
+    }
+    const int pml_grow = (do_pml_in_domain) ? 0 : pml_ncell;
+
+    for (const auto& i : costs[lev]->IndexArray())
+    {
+        const Box& vbx = ba[i];
+        amrex::Real* f = &features[i*nf];
+        f[i_overhead] = 1.0_rt;
+        f[i_cells] = static_cast<amrex::Real>(vbx.d_numPts());
+
+        const Box gbx = amrex::grow(vbx, pml_grow);
+        for (const Box& b : pml_region)
+        {
+            const Box pml_box = gbx & b;
+            if (pml_box.ok()) { f[i_pml] += static_cast<amrex::Real>(pml_box.d_numPts()); }
+        }
+
+        // Binary collision pairs, assuming that the particles are uniformly
+        // distributed in the box
+        for (const auto& c : m_cost_model_collisions)
+        {
+            const amrex::Real n1 = f[i_particles + c[0]];
+            const amrex::Real n2 = f[i_particles + c[1]];
+            f[i_collisions] += ((c[0] == c[1]) ? 0.5_rt : 1.0_rt)*n1*n2/(f[i_cells]*c[2]);
+        }
+    }
+
+#ifdef AMREX_USE_EB
+    if (EB::enabled())
+    {
+        auto const& flags = fieldEBFactory(lev).getMultiEBCellFlagFab();
+        for (MFIter mfi(flags); mfi.isValid(); ++mfi)
+        {
+            features[mfi.index()*nf + i_eb] =
+                static_cast<amrex::Real>(countCutCells(flags[mfi], mfi.validbox()));
+        }
+    }
+#else
+    amrex::ignore_unused(i_eb);
+#endif
+
+    ParallelAllReduce::Sum(features.data(), static_cast<int>(features.size()),
+                           ParallelContext::CommunicatorSub());
+    return features;
+}
+
+void
+WarpX::UpdateCostModel (int step)
+{
+    WARPX_PROFILE("WarpX::UpdateCostModel()");
+
+    AMREX_ALWAYS_ASSERT(costs.size() == finest_level + 1);
+
+    if (!m_cost_model)
+    {
+        std::vector<std::string> feature_names = {"overhead", "cells"};
+        for (const auto& name : mypc->GetSpeciesNames()) {
+            feature_names.push_back("particles_" + name);
+        }
+        feature_names.insert(feature_names.end(), {"pml_cells", "eb_cut_cells", "collision_pairs"});
+        m_cost_model = std::make_unique<CostModel>(feature_names, costs_model_history);
+
+        // species of the binary collisions
+        const ParmParse pp_collisions("collisions");
+        std::vector<std::string> collision_names;
+        pp_collisions.queryarr("collision_names", collision_names);
+        for (const auto& name : collision_names)
+        {
+            const ParmParse pp_collision_name(name);
+            std::vector<std::string> species_names;
+            pp_collision_name.queryarr("species", species_names);
+            if (species_names.size() != 2) { continue; }
+            int ndt = 1;
+            utils::parser::queryWithParser(pp_collision_name, "ndt", ndt);
+            m_cost_model_collisions.push_back({mypc->getSpeciesID(species_names[0]),
+                                               mypc->getSpeciesID(species_names[1]),
+                                               std::max(ndt, 1)});
+        }
+    }
+
+    // number of steps over which the timers accumulated the costs
+    const int nsteps = std::max(1, (m_cost_model_step >= 0)
+        ? step - m_cost_model_step
+        : step + 1 - std::max(0, load_balance_intervals.previousContains(step+1)));
+
+    const int nLevels = finest_level + 1;
+    const int nf = m_cost_model->nFeatures();
+    m_cost_model_features.resize(nLevels);
+    Vector<std::vector<amrex::Real>> features(nLevels);
+    std::vector<amrex::Real> sample_features;
+    std::vector<amrex::Real> sample_costs;
+    for (int lev = 0; lev < nLevels; ++lev)
+    {
+        features[lev] = ComputeCostModelFeatures(lev);
+        auto const& prev = m_cost_model_features[lev];
+        const bool has_prev = (prev.size() == features[lev].size());
+
+        const int nboxes = costs[lev]->size();
+        std::vector<amrex::Real> measured(nboxes, 0.0_rt);
+        for (const auto& i : costs[lev]->IndexArray())
+        {
+            measured[i] = (*costs[lev])[i]/nsteps;
+        }
+        ParallelAllReduce::Sum(measured.data(), nboxes, ParallelContext::CommunicatorSub());
+
+        // The measured costs are averaged over the interval: pair them with
+        // the features averaged over the beginning and the end of the interval
+        for (std::size_t k = 0; k < features[lev].size(); ++k)
+        {
+            sample_features.push_back(
+                (has_prev) ? 0.5_rt*(prev[k] + features[lev][k]) : features[lev][k]);
+        }
+        sample_costs.insert(sample_costs.end(), measured.begin(), measured.end());
+    }
+    m_cost_model->AddSample(sample_features, sample_costs);
+
+    const bool fitted = m_cost_model->Fit();
+    const bool use_model = fitted && (m_cost_model->RSquared() >= costs_model_min_r2);
+
+    if (fitted && verbose)
+    {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Load balance cost model: R^2 = " + std::to_string(m_cost_model->RSquared())
+            + ", relative residual = " + std::to_string(m_cost_model->RelativeResidual())
+            + ((use_model) ? "" : "; using the measured costs"));
+    }
+
+    if (use_model)
+    {
+        // Predict the costs at the middle of the next interval, extrapolating
+        // the features linearly from the previous interval
+        const int next_nsteps = std::min(load_balance_intervals.localPeriod(step+1), 2*nsteps);
+        const amrex::Real horizon = (costs_model_extrapolate)
+            ? 0.5_rt*static_cast<amrex::Real>(next_nsteps)/static_cast<amrex::Real>(nsteps)
+            : 0.0_rt;
+        std::vector<amrex::Real> f(nf);
+        for (int lev = 0; lev < nLevels; ++lev)
+        {
+            auto const& cur = features[lev];
+            auto const& prev = m_cost_model_features[lev];
+            const bool has_prev = (prev.size() == cur.size());
+            for (const auto& i : costs[lev]->IndexArray())
+            {
+                for (int j = 0; j < nf; ++j)
+                {
+                    const std::size_t k = static_cast<std::size_t>(i)*nf + j;
+                    f[j] = (has_prev)
+                        ? std::max(0.0_rt, cur[k] + horizon*(cur[k] - prev[k]))
+                        : cur[k];
+                }
+                (*costs[lev])[i] = m_cost_model->Predict(f.data());
+            }
+        }
+    }
+
+    m_cost_model_features = std::move(features);
+    m_cost_model_step = step;
+}
+
 void
 WarpX::ResetCosts ()
 {
@@ -446,6 +1057,13 @@ WarpX::ResetCosts ()
             // Reset costs
             (*costs[lev])[i] = 0.0;
         }
+        if (particle_costs[lev])
+        {
+            for (const auto& i : particle_costs[lev]->IndexArray())
+            {
+                (*particle_costs[lev])[i] = 0.0;
+            }
+        }
     }
 }
 
@@ -473,5 +1091,12 @@ WarpX::RescaleCosts (int step)
                 (*costs[lev])[i] *= (1._rt - 2._rt/load_balance_intervals.localPeriod(step+1));
             }
         }
+        if (particle_costs[lev])
+        {
+            for (const auto& i : particle_costs[lev]->IndexArray())
+            {
+                (*particle_costs[lev])[i] *= (1._rt - 2._rt/load_balance_intervals.localPeriod(step+1));
+            }
+        }
     }
 }
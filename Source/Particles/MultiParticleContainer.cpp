@@ -33,6 +33,7 @@
 #include "Particles/PhysicalParticleContainer.H"
 #include "Particles/RigidInjectedParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Parallelization/ParallelTasks.H"
 #include "SpeciesPhysicalProperties.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
@@ -62,6 +63,7 @@
 #include <AMReX_MultiFab.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_ParIter.H>
+#include <AMReX_ParallelContext.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_ParticleTile.H>
@@ -73,6 +75,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <map>
 #include <string>
@@ -89,6 +92,17 @@ namespace
     {
         Array4< amrex::Real const > const Ex, Ey, Ez, Bx, By, Bz;
     };
+
+#ifdef WARPX_QED
+    /** Send the raw data of a QED lookup table from the rank that generated it to all the ranks */
+    void BcastTableData (Vector<char>& table_data, int root)
+    {
+        auto size = static_cast<Long>(table_data.size());
+        ParallelDescriptor::Bcast(&size, 1, root);
+        table_data.resize(size);
+        ParallelDescriptor::Bcast(table_data.data(), size, root);
+    }
+#endif
 }
 
 MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
@@ -466,9 +480,9 @@ MultiParticleContainer::Evolve (int lev,
                                 const MultiFab* cEx, const MultiFab* cEy, const MultiFab* cEz,
                                 const MultiFab* cBx, const MultiFab* cBy, const MultiFab* cBz,
                                 Real t, Real dt, DtType a_dt_type, bool skip_deposition,
-                                PushType push_type)
+                                PushType push_type, EvolveTiles tiles, amrex::IntVect tile_margin)
 {
-    if (! skip_deposition) {
+    if (! skip_deposition && tiles != EvolveTiles::Interior) {
         jx.setVal(0.0);
         jy.setVal(0.0);
         jz.setVal(0.0);
@@ -479,8 +493,10 @@ MultiParticleContainer::Evolve (int lev,
         if (crho) { crho->setVal(0.0); }
     }
     for (auto& pc : allcontainers) {
+        pc->SetEvolveTiles(tiles, tile_margin);
         pc->Evolve(lev, Ex, Ey, Ez, Bx, By, Bz, jx, jy, jz, cjx, cjy, cjz,
                    rho, crho, cEx, cEy, cEz, cBx, cBy, cBz, t, dt, a_dt_type, skip_deposition, push_type);
+        pc->SetEvolveTiles(EvolveTiles::All);
     }
 }
 
@@ -508,7 +524,9 @@ MultiParticleContainer::GetZeroChargeDensity (const int lev)
     const WarpX& warpx = WarpX::GetInstance();
 
     BoxArray nba = warpx.boxArray(lev);
-    const DistributionMapping dmap = warpx.DistributionMap(lev);
+    // the particles may have their own distribution mapping (algo.load_balance_particles_only)
+    const DistributionMapping dmap = (allcontainers.empty())
+        ? warpx.DistributionMap(lev) : allcontainers[0]->ParticleDistributionMap(lev);
     const int ng_rho = warpx.get_ng_depos_rho().max();
 
 #ifdef WARPX_DIM_RZ
@@ -602,6 +620,14 @@ MultiParticleContainer::GetChargeDensity (int lev, bool local)
         const std::unique_ptr<MultiFab> rhoi = container->GetChargeDensity(lev, true);
         MultiFab::Add(*rho, *rhoi, 0, 0, rho->nComp(), rho->nGrowVect());
     }
+    const WarpX& warpx = WarpX::GetInstance();
+    if (!warpx.ParticlesOnFieldGrids(lev)) {
+        // send the charge density back to the owners of the field boxes
+        auto rho_fields = std::make_unique<MultiFab>(
+            rho->boxArray(), warpx.DistributionMap(lev), rho->nComp(), rho->nGrowVect());
+        rho_fields->Redistribute(*rho, 0, 0, rho->nComp(), rho->nGrowVect());
+        rho = std::move(rho_fields);
+    }
     if (!local) {
         const Geometry& gm = allcontainers[0]->Geom(lev);
         // Possible performance optimization:
@@ -629,6 +655,7 @@ MultiParticleContainer::SortParticlesByBin (amrex::IntVect bin_size)
 void
 MultiParticleContainer::Redistribute ()
 {
+    CountRedistributedParticles();
     for (auto& pc : allcontainers) {
         pc->Redistribute();
     }
@@ -653,11 +680,23 @@ MultiParticleContainer::deleteInvalidParticles ()
 void
 MultiParticleContainer::RedistributeLocal (const int num_ghost)
 {
+    CountRedistributedParticles();
     for (auto& pc : allcontainers) {
         pc->Redistribute(0, 0, 0, num_ghost);
     }
 }
 
+void
+MultiParticleContainer::CountRedistributedParticles ()
+{
+    if (!m_count_redistributed_particles) { return; }
+
+    m_redistribute_statistics.resize(nSpecies());
+    for (int i = 0; i < nSpecies(); ++i) {
+        m_redistribute_statistics[i] = allcontainers[i]->CountRedistributedParticles();
+    }
+}
+
 void
 MultiParticleContainer::ApplyBoundaryConditions ()
 {
@@ -879,7 +918,7 @@ MultiParticleContainer::doFieldIonization (int lev,
 {
     WARPX_PROFILE("MultiParticleContainer::doFieldIonization()");
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getParticleCosts(lev);
 
     // Loop over all species.
     // Ionized particles in pc_source create particles in pc_product
@@ -905,7 +944,7 @@ MultiParticleContainer::doFieldIonization (int lev,
 #endif
         for (WarpXParIter pti(*pc_source, lev, info); pti.isValid(); ++pti)
         {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
             }
@@ -924,7 +963,7 @@ MultiParticleContainer::doFieldIonization (int lev,
 
             setNewParticleIDs(dst_tile, np_dst, num_added);
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
                 wt = static_cast<amrex::Real>(amrex::second()) - wt;
@@ -992,17 +1031,46 @@ void MultiParticleContainer::InitQED ()
         }
     }
 
-    if(m_nspecies_quantum_sync != 0) {
-        InitQuantumSync();
-    }
+    const bool generate_qs_table = (m_nspecies_quantum_sync != 0) && InitQuantumSync();
+    const bool generate_bw_table = (m_nspecies_breit_wheeler != 0) && InitBreitWheeler();
 
-    if(m_nspecies_breit_wheeler !=0) {
-        InitBreitWheeler();
+#ifdef WARPX_QED_TABLE_GEN
+    // The new tables are generated by the I/O processor, or, with warpx.do_task_parallel_init,
+    // concurrently on different groups of MPI ranks, and then sent to all the ranks
+    std::vector<std::function<void()>> generate_tables;
+    if (generate_qs_table) {
+        generate_tables.emplace_back([this](){ QuantumSyncGenerateTable(); });
+    }
+    if (generate_bw_table) {
+        generate_tables.emplace_back([this](){ BreitWheelerGenerateTable(); });
+    }
+    std::vector<int> table_roots;
+    if (WarpX::do_task_parallel_init) {
+        table_roots = warpx::parallel_tasks::RunConcurrently(generate_tables);
+    } else {
+        for (auto const& generate_table : generate_tables) { generate_table(); }
+        table_roots.assign(generate_tables.size(), ParallelDescriptor::IOProcessorNumber());
+    }
+    int itable = 0;
+    if (generate_qs_table) {
+        QuantumSyncShareTable(table_roots[itable++]);
+    }
+    if (generate_bw_table) {
+        BreitWheelerShareTable(table_roots[itable++]);
     }
+#else
+    amrex::ignore_unused(generate_qs_table, generate_bw_table);
+#endif
 
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        (m_nspecies_quantum_sync == 0) || m_shr_p_qs_engine->are_lookup_tables_initialized(),
+        "Table initialization has failed!");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        (m_nspecies_breit_wheeler == 0) || m_shr_p_bw_engine->are_lookup_tables_initialized(),
+        "Table initialization has failed!");
 }
 
-void MultiParticleContainer::InitQuantumSync ()
+bool MultiParticleContainer::InitQuantumSync ()
 {
     std::string lookup_table_mode;
     const ParmParse pp_qed_qs("qed_qs");
@@ -1039,9 +1107,8 @@ void MultiParticleContainer::InitQuantumSync ()
             ablastr::warn_manager::WarnPriority::low);
 #ifndef WARPX_QED_TABLE_GEN
         WARPX_ABORT_WITH_MESSAGE("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
-#else
-        QuantumSyncGenerateTable();
 #endif
+        return true;
     }
     else if(lookup_table_mode == "load"){
         std::string load_table_name;
@@ -1069,12 +1136,10 @@ void MultiParticleContainer::InitQuantumSync ()
         WARPX_ABORT_WITH_MESSAGE("Unknown Quantum Synchrotron table mode");
     }
 
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        m_shr_p_qs_engine->are_lookup_tables_initialized(),
-        "Table initialization has failed!");
+    return false;
 }
 
-void MultiParticleContainer::InitBreitWheeler ()
+bool MultiParticleContainer::InitBreitWheeler ()
 {
     std::string lookup_table_mode;
     const ParmParse pp_qed_bw("qed_bw");
@@ -1098,9 +1163,8 @@ void MultiParticleContainer::InitBreitWheeler ()
             ablastr::warn_manager::WarnPriority::low);
 #ifndef WARPX_QED_TABLE_GEN
         amrex::Error("Error: Compile with QED_TABLE_GEN=TRUE to enable table generation!\n");
-#else
-        BreitWheelerGenerateTable();
 #endif
+        return true;
     }
     else if(lookup_table_mode == "load"){
         std::string load_table_name;
@@ -1128,9 +1192,7 @@ void MultiParticleContainer::InitBreitWheeler ()
         WARPX_ABORT_WITH_MESSAGE("Unknown Breit Wheeler table mode");
     }
 
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        m_shr_p_bw_engine->are_lookup_tables_initialized(),
-        "Table initialization has failed!");
+    return false;
 }
 
 void
@@ -1149,7 +1211,7 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     amrex::Real qs_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
+    if(ParallelContext::IOProcessorSub()){
         PicsarQuantumSyncCtrl ctrl;
 
         //==Table parameters==
@@ -1209,15 +1271,25 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
         WarpXUtilIO::WriteBinaryDataOnFile(table_name,
             Vector<char>{data.begin(), data.end()});
     }
+}
+
+void
+MultiParticleContainer::QuantumSyncShareTable (int root)
+{
+    const ParmParse pp_qed_qs("qed_qs");
+    amrex::Real qs_minimum_chi_part;
+    utils::parser::getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    ParallelDescriptor::Barrier();
     Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+    if(ParallelDescriptor::MyProc() == root){
+        const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
+        table_data.assign(data.begin(), data.end());
+    }
+    BcastTableData(table_data, root);
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
+    if(ParallelDescriptor::MyProc() != root){
         m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
             table_data, qs_minimum_chi_part);
     }
@@ -1239,7 +1311,7 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     amrex::Real bw_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
+    if(ParallelContext::IOProcessorSub()){
         PicsarBreitWheelerCtrl ctrl;
 
         //==Table parameters==
@@ -1294,15 +1366,25 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
         WarpXUtilIO::WriteBinaryDataOnFile(table_name,
             Vector<char>{data.begin(), data.end()});
     }
+}
+
+void
+MultiParticleContainer::BreitWheelerShareTable (int root)
+{
+    const ParmParse pp_qed_bw("qed_bw");
+    amrex::Real bw_minimum_chi_part;
+    utils::parser::getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    ParallelDescriptor::Barrier();
     Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+    if(ParallelDescriptor::MyProc() == root){
+        const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
+        table_data.assign(data.begin(), data.end());
+    }
+    BcastTableData(table_data, root);
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
-    if(!ParallelDescriptor::IOProcessor()){
+    if(ParallelDescriptor::MyProc() != root){
         m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
             table_data, bw_minimum_chi_part);
     }
@@ -1502,7 +1584,7 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
 {
     WARPX_PROFILE("MultiParticleContainer::doQedBreitWheeler()");
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getParticleCosts(lev);
 
     // Loop over all species.
     // Photons undergoing Breit Wheeler process create electrons
@@ -1538,7 +1620,7 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
 #endif
         for (WarpXParIter pti(*pc_source, lev, info); pti.isValid(); ++pti)
         {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
             }
@@ -1565,7 +1647,7 @@ void MultiParticleContainer::doQedBreitWheeler (int lev,
             setNewParticleIDs(dst_ele_tile, np_dst_ele, num_added);
             setNewParticleIDs(dst_pos_tile, np_dst_pos, num_added);
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
                 wt = static_cast<amrex::Real>(amrex::second()) - wt;
@@ -1585,7 +1667,7 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
 {
     WARPX_PROFILE("MultiParticleContainer::doQedQuantumSync()");
 
-    amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
+    amrex::LayoutData<amrex::Real>* cost = WarpX::getParticleCosts(lev);
 
     // Loop over all species.
     // Electrons or positrons undergoing Quantum photon emission process
@@ -1615,7 +1697,7 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
 #endif
         for (WarpXParIter pti(*pc_source, lev, info); pti.isValid(); ++pti)
         {
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
             }
@@ -1646,7 +1728,7 @@ void MultiParticleContainer::doQedQuantumSync (int lev,
                                   dst_tile, np_dst, num_added,
                                   m_quantum_sync_photon_creation_energy_threshold);
 
-            if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (cost && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
                 wt = static_cast<amrex::Real>(amrex::second()) - wt;
@@ -304,8 +304,11 @@ RigidInjectedParticleContainer::Evolve (int lev,
 {
 
     // Update location of injection plane in the boosted frame
-    zinject_plane_lev_previous = zinject_plane_levels[lev];
-    zinject_plane_levels[lev] -= dt*WarpX::beta_boost*PhysConst::c;
+    // (once per step, with the deposition in two passes)
+    if (m_evolve_tiles != EvolveTiles::Interior) {
+        zinject_plane_lev_previous = zinject_plane_levels[lev];
+        zinject_plane_levels[lev] -= dt*WarpX::beta_boost*PhysConst::c;
+    }
     zinject_plane_lev = zinject_plane_levels[lev];
 
     // Set the done injecting flag when the inject plane moves out of the
@@ -34,6 +34,7 @@
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
+#include <AMReX_DenseBins.H>
 #include <AMReX_Dim3.H>
 #include <AMReX_Extension.H>
 #include <AMReX_FabArray.H>
@@ -56,6 +57,7 @@
 #include <AMReX_ParmParse.H>
 #include <AMReX_Particle.H>
 #include <AMReX_ParticleContainerBase.H>
+#include <AMReX_ParticleLocator.H>
 #include <AMReX_ParticleTile.H>
 #include <AMReX_ParticleTransformation.H>
 #include <AMReX_ParticleUtil.H>
@@ -1456,6 +1458,74 @@ amrex::ParticleReal WarpXParticleContainer::maxParticleVelocity(bool local) {
     return max_v;
 }
 
+WarpXParticleContainer::RedistributeStatistics
+WarpXParticleContainer::CountRedistributedParticles ()
+{
+    RedistributeStatistics stats;
+
+    const int myproc = ParallelDescriptor::MyProc();
+    const int nLevels = finestLevel();
+    for (int lev = 0; lev <= nLevels; ++lev)
+    {
+        const Geometry& geom = Geom(lev);
+        const auto plo = geom.ProbLoArray();
+        const auto dxi = geom.InvCellSizeArray();
+        const Box domain = geom.Domain();
+        const auto is_periodic = geom.isPeriodicArray();
+
+        // Locate the new grid of the particles on the device, as done in the Redistribute
+        amrex::ParticleLocator<amrex::DenseBins<Box>> locator;
+        locator.build(ParticleBoxArray(lev), geom);
+        const auto assign_grid = locator.getGridAssignor();
+
+        const Vector<int>& pmap = ParticleDistributionMap(lev).ProcessorMap();
+        Gpu::DeviceVector<int> owner(pmap.size());
+        Gpu::copyAsync(Gpu::hostToDevice, pmap.begin(), pmap.end(), owner.begin());
+        const int* owner_ptr = owner.dataPtr();
+
+        ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
+        ReduceData<Long, Long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+
+        for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
+        {
+            const int grid = pti.index();
+            const auto ptd = pti.GetParticleTile().getConstParticleTileData();
+
+            reduce_op.eval(pti.numParticles(), reduce_data,
+                [=] AMREX_GPU_DEVICE (int ip) -> ReduceTuple
+                {
+                    Long moved = 0;
+                    Long sent = 0;
+                    if (amrex::ParticleIDWrapper{ptd.m_idcpu[ip]}.is_valid())
+                    {
+                        IntVect iv = getParticleCell(ptd, ip, plo, dxi, domain);
+                        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                            if (!is_periodic[idim]) { continue; }
+                            const int n = domain.length(idim);
+                            const int shift = iv[idim] - domain.smallEnd(idim);
+                            iv[idim] = domain.smallEnd(idim) + ((shift % n) + n) % n;
+                        }
+                        const int new_grid = assign_grid(iv);
+                        if (new_grid != grid) {
+                            moved = 1;
+                            // Particles leaving the domain (new_grid < 0) are deleted
+                            if (new_grid >= 0 && owner_ptr[new_grid] != myproc) { sent = 1; }
+                        }
+                    }
+                    return {moved, sent};
+                });
+        }
+
+        const ReduceTuple hv = reduce_data.value();
+        stats.num_moved += amrex::get<0>(hv);
+        stats.num_sent += amrex::get<1>(hv);
+    }
+
+    stats.bytes_sent = stats.num_sent * static_cast<Long>(superParticleSize());
+    return stats;
+}
+
 void
 WarpXParticleContainer::PushX (amrex::Real dt)
 {
@@ -1472,7 +1542,7 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
 
     if (do_not_push) { return; }
 
-    amrex::LayoutData<amrex::Real>* costs = WarpX::getCosts(lev);
+    amrex::LayoutData<amrex::Real>* costs = WarpX::getParticleCosts(lev);
 
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
@@ -1481,7 +1551,7 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
 
         for (WarpXParIter pti(*this, lev); pti.isValid(); ++pti)
         {
-            if (costs && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (costs && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
             }
@@ -1510,7 +1580,7 @@ WarpXParticleContainer::PushX (int lev, amrex::Real dt)
                 }
             );
 
-            if (costs && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
+            if (costs && WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic)
             {
                 amrex::Gpu::synchronize();
                 wt = static_cast<amrex::Real>(amrex::second()) - wt;
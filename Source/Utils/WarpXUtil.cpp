@@ -490,7 +490,7 @@ namespace WarpXUtilLoadBalance
     {
         const bool consistent = cost && (dm == cost->DistributionMap()) &&
             (ba.CellEqual(cost->boxArray())) &&
-            (WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers);
+            (WarpX::load_balance_costs_update_algo != LoadBalanceCostsUpdateAlgo::Heuristic);
         return consistent;
     }
 }
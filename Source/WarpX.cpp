@@ -31,6 +31,7 @@
 #include "FieldSolver/WarpX_FDTD.H"
 #include "Filter/NCIGodfreyFilter.H"
 #include "Initialization/ExternalField.H"
+#include "Parallelization/CostModel.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Fluids/MultiFluidContainer.H"
 #include "Fluids/WarpXFluidContainer.H"
@@ -98,6 +99,7 @@ int WarpX::moving_window_dir = -1;
 Real WarpX::moving_window_v = std::numeric_limits<amrex::Real>::max();
 
 bool WarpX::fft_do_time_averaging = false;
+bool WarpX::fft_on_the_fly_coefficients = false;
 
 amrex::IntVect WarpX::m_fill_guards_fields  = amrex::IntVect(0);
 amrex::IntVect WarpX::m_fill_guards_current = amrex::IntVect(0);
@@ -183,6 +185,10 @@ bool WarpX::do_subcycling = false;
 bool WarpX::do_multi_J = false;
 int WarpX::do_multi_J_n_depositions;
 bool WarpX::safe_guard_cells = false;
+bool WarpX::do_fdtd_comm_overlap = false;
+bool WarpX::do_fdtd_temporal_blocking = false;
+bool WarpX::do_current_comm_overlap = false;
+bool WarpX::do_task_parallel_init = false;
 
 std::map<std::string, amrex::MultiFab *> WarpX::multifab_map;
 std::map<std::string, amrex::iMultiFab *> WarpX::imultifab_map;
@@ -391,6 +397,9 @@ WarpX::WarpX ()
     do_pml_Hi.resize(nlevs_max);
 
     costs.resize(nlevs_max);
+    particle_costs.resize(nlevs_max);
+    Efield_aux_particle_grids.resize(nlevs_max);
+    Bfield_aux_particle_grids.resize(nlevs_max);
     load_balance_efficiency.resize(nlevs_max);
 
     m_field_factory.resize(nlevs_max);
@@ -660,6 +669,10 @@ WarpX::ReadParameters ()
         }
         pp_warpx.query("use_hybrid_QED", use_hybrid_QED);
         pp_warpx.query("safe_guard_cells", safe_guard_cells);
+        pp_warpx.query("do_fdtd_comm_overlap", do_fdtd_comm_overlap);
+        pp_warpx.query("do_fdtd_temporal_blocking", do_fdtd_temporal_blocking);
+        pp_warpx.query("do_current_comm_overlap", do_current_comm_overlap);
+        pp_warpx.query("do_task_parallel_init", do_task_parallel_init);
         std::vector<std::string> override_sync_intervals_string_vec = {"1"};
         pp_warpx.queryarr("override_sync_intervals", override_sync_intervals_string_vec);
         override_sync_intervals =
@@ -1343,6 +1356,80 @@ WarpX::ReadParameters ()
                                       macroscopic_solver_algo, "-_");
         }
 
+        if (do_fdtd_comm_overlap) {
+            // the boundary cells of the boxes are pushed after the guard-cell exchange,
+            // which is only implemented for the plain Cartesian FDTD push in vacuum
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                evolve_scheme == EvolveScheme::Explicit &&
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                em_solver_medium == MediumForEM::Vacuum,
+                "warpx.do_fdtd_comm_overlap = 1 is only implemented for the explicit "
+                "Yee and CKC solvers in vacuum");
+#ifdef WARPX_DIM_RZ
+            WARPX_ABORT_WITH_MESSAGE(
+                "warpx.do_fdtd_comm_overlap = 1 is not implemented in RZ geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !isAnyBoundaryPML() && !EB::enabled() &&
+                !do_dive_cleaning && !do_divb_cleaning && !use_hybrid_QED,
+                "warpx.do_fdtd_comm_overlap = 1 is not implemented with mesh refinement, "
+                "PML, embedded boundaries, div(E)/div(B) cleaning or hybrid QED");
+        }
+
+        if (do_fdtd_temporal_blocking) {
+            // E and B are updated box by box without applying the field boundary conditions
+            // in between, which is only implemented for the plain Cartesian FDTD push
+            // with periodic boundaries
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                evolve_scheme == EvolveScheme::Explicit &&
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC) &&
+                grid_type != GridType::Collocated,
+                "warpx.do_fdtd_temporal_blocking = 1 is only implemented for the explicit "
+                "Yee and CKC solvers, on a staggered grid");
+#ifdef WARPX_DIM_RZ
+            WARPX_ABORT_WITH_MESSAGE(
+                "warpx.do_fdtd_temporal_blocking = 1 is not implemented in RZ geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !EB::enabled() &&
+                !do_dive_cleaning && !do_divb_cleaning && !use_hybrid_QED,
+                "warpx.do_fdtd_temporal_blocking = 1 is not implemented with mesh refinement, "
+                "embedded boundaries, div(E)/div(B) cleaning or hybrid QED");
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    field_boundary_lo[idim] == FieldBoundaryType::Periodic &&
+                    field_boundary_hi[idim] == FieldBoundaryType::Periodic,
+                    "warpx.do_fdtd_temporal_blocking = 1 is only implemented with periodic "
+                    "field boundaries");
+            }
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_fdtd_comm_overlap,
+                "warpx.do_fdtd_temporal_blocking and warpx.do_fdtd_comm_overlap "
+                "cannot be used together");
+        }
+
+        if (do_current_comm_overlap) {
+            // the sum of the guard cells of J is started during the deposition, so it must
+            // be the first operation of WarpX::SyncCurrent
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                evolve_scheme == EvolveScheme::Explicit &&
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::ECT),
+                "warpx.do_current_comm_overlap = 1 is only implemented for the explicit "
+                "FDTD solvers");
+#ifdef WARPX_DIM_RZ
+            WARPX_ABORT_WITH_MESSAGE(
+                "warpx.do_current_comm_overlap = 1 is not implemented in RZ geometry");
+#endif
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !use_filter && !do_current_centering && !do_fluid_species,
+                "warpx.do_current_comm_overlap = 1 is not implemented with mesh refinement, "
+                "the current filter (warpx.use_filter = 0 is needed), "
+                "current centering or fluid species");
+        }
+
         if (evolve_scheme == EvolveScheme::SemiImplicitEM ||
             evolve_scheme == EvolveScheme::ThetaImplicitEM) {
 
@@ -1373,6 +1460,22 @@ WarpX::ReadParameters ()
         load_balance_intervals = utils::parser::IntervalsParser(
             load_balance_intervals_string_vec);
         pp_algo.query("load_balance_with_sfc", load_balance_with_sfc);
+        pp_algo.query("load_balance_hierarchical", load_balance_hierarchical);
+        pp_algo.query("load_balance_with_topology", load_balance_with_topology);
+        if (load_balance_with_topology) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!load_balance_hierarchical,
+                "algo.load_balance_with_topology and algo.load_balance_hierarchical cannot be both used");
+            utils::parser::queryWithParser(
+                pp_algo, "load_balance_topology_node_tolerance", load_balance_topology_node_tolerance);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(load_balance_topology_node_tolerance >= 0,
+                "algo.load_balance_topology_node_tolerance must be non-negative");
+        }
+        if (load_balance_hierarchical || load_balance_with_topology) {
+            utils::parser::queryWithParser(
+                pp_algo, "load_balance_ranks_per_node", load_balance_ranks_per_node);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(load_balance_ranks_per_node >= 0,
+                "algo.load_balance_ranks_per_node must be non-negative");
+        }
         // Knapsack factor only used with non-SFC strategy
         if (!load_balance_with_sfc) {
             pp_algo.query("load_balance_knapsack_factor", load_balance_knapsack_factor);
@@ -1386,6 +1489,70 @@ WarpX::ReadParameters ()
             utils::parser::queryWithParser(
                 pp_algo, "costs_heuristic_particles_wt", costs_heuristic_particles_wt);
         }
+        if (WarpX::load_balance_costs_update_algo==LoadBalanceCostsUpdateAlgo::Model) {
+            utils::parser::queryWithParser(
+                pp_algo, "costs_model_history", costs_model_history);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(costs_model_history > 0,
+                "algo.costs_model_history must be positive");
+            pp_algo.query("costs_model_extrapolate", costs_model_extrapolate);
+            utils::parser::queryWithParser(
+                pp_algo, "costs_model_min_r2", costs_model_min_r2);
+        }
+        pp_algo.query("load_balance_regrid", load_balance_regrid);
+        if (load_balance_regrid) {
+            utils::parser::queryWithParser(
+                pp_algo, "load_balance_regrid_split_fraction", load_balance_regrid_split_fraction);
+            utils::parser::queryWithParser(
+                pp_algo, "load_balance_regrid_merge_fraction", load_balance_regrid_merge_fraction);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                load_balance_regrid_merge_fraction >= 0 &&
+                load_balance_regrid_merge_fraction < load_balance_regrid_split_fraction,
+                "algo.load_balance_regrid_merge_fraction must be non-negative and smaller than "
+                "algo.load_balance_regrid_split_fraction");
+            // the boxes of all the fields of level 0 are remade; the objects that are
+            // built on these boxes once (PML, embedded boundaries, spectral solvers,
+            // implicit solvers, fluids) are not
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                evolve_scheme == EvolveScheme::Explicit &&
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::None),
+                "algo.load_balance_regrid = 1 is only implemented for the explicit "
+                "Yee and CKC solvers and the electrostatic solvers");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !isAnyBoundaryPML() && !EB::enabled() && !do_fluid_species,
+                "algo.load_balance_regrid = 1 is not implemented with mesh refinement, "
+                "PML, embedded boundaries or fluid species");
+        }
+
+        pp_algo.query("load_balance_particles_only", load_balance_particles_only);
+        if (load_balance_particles_only) {
+            // the particles then live on their own distribution mapping, and gather and
+            // deposit through copies of the fields; only the explicit FDTD push of the
+            // particles on a single level goes through these copies
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                evolve_scheme == EvolveScheme::Explicit &&
+                (electromagnetic_solver_id == ElectromagneticSolverAlgo::Yee ||
+                 electromagnetic_solver_id == ElectromagneticSolverAlgo::CKC),
+                "algo.load_balance_particles_only = 1 is only implemented for the explicit "
+                "Yee and CKC solvers");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !EB::enabled() && !do_fluid_species &&
+                !do_current_centering && !do_current_comm_overlap && !load_balance_regrid,
+                "algo.load_balance_particles_only = 1 is not implemented with mesh refinement, "
+                "embedded boundaries, fluid species, current centering, "
+                "warpx.do_current_comm_overlap = 1 or algo.load_balance_regrid = 1");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers,
+                "algo.load_balance_particles_only = 1 requires algo.load_balance_costs_update = Timers");
+#ifdef WARPX_QED
+            bool do_qed_schwinger = false;
+            const ParmParse pp_warpx("warpx");
+            pp_warpx.query("do_qed_schwinger", do_qed_schwinger);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!do_qed_schwinger,
+                "algo.load_balance_particles_only = 1 is not implemented with the Schwinger process");
+#endif
+        }
 
         // Parse algo.particle_shape and check that input is acceptable
         // (do this only if there is at least one particle or laser species)
@@ -1516,6 +1683,40 @@ WarpX::ReadParameters ()
     {
         const ParmParse pp_psatd("psatd");
         pp_psatd.query("periodic_single_box_fft", fft_periodic_single_box);
+        pp_psatd.query("distributed_fft", fft_distributed);
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !fft_distributed || fft_periodic_single_box,
+            "psatd.distributed_fft=1 requires psatd.periodic_single_box_fft=1");
+#if !defined(WARPX_USE_HEFFTE) || defined(WARPX_DIM_RZ) || defined(WARPX_DIM_1D_Z)
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !fft_distributed,
+            "psatd.distributed_fft=1 requires a 2D or 3D Cartesian build of WarpX with heFFTe (WarpX_HEFFTE=ON)");
+#endif
+
+        pp_psatd.query("keep_fields_in_spectral_space", fft_keep_fields_in_spectral_space);
+        if (fft_keep_fields_in_spectral_space) {
+            // the spectral fields must cover exactly the valid domain, and the real-space
+            // fields must not be modified between the backward and the next forward FFT
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                fft_periodic_single_box,
+                "psatd.keep_fields_in_spectral_space=1 requires psatd.periodic_single_box_fft=1");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                maxLevel() == 0 && !do_moving_window && num_mirrors == 0 &&
+                !use_hybrid_QED && !isAnyBoundaryPML(),
+                "psatd.keep_fields_in_spectral_space=1 is not implemented with mesh refinement, "
+                "a moving window, mirrors, hybrid QED or PML");
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                    field_boundary_lo[idim] == FieldBoundaryType::Periodic &&
+                    field_boundary_hi[idim] == FieldBoundaryType::Periodic,
+                    "psatd.keep_fields_in_spectral_space=1 is only implemented with periodic "
+                    "field boundaries");
+            }
+#ifdef WARPX_DIM_RZ
+            WARPX_ABORT_WITH_MESSAGE(
+                "psatd.keep_fields_in_spectral_space=1 is not implemented in RZ geometry");
+#endif
+        }
 
         std::string nox_str;
         std::string noy_str;
@@ -1598,6 +1799,7 @@ WarpX::ReadParameters ()
         }
 
         pp_psatd.query("do_time_averaging", fft_do_time_averaging);
+        pp_psatd.query("on_the_fly_coefficients", fft_on_the_fly_coefficients);
 
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
@@ -2151,6 +2353,11 @@ WarpX::ClearLevel (int lev)
 #endif
 
     costs[lev].reset();
+    particle_costs[lev].reset();
+    for (int i = 0; i < 3; ++i) {
+        Efield_aux_particle_grids[lev][i].reset();
+        Bfield_aux_particle_grids[lev][i].reset();
+    }
     load_balance_efficiency[lev] = -1;
 }
 
@@ -2561,8 +2768,9 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
 #   else
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
                 geom[0].isAllPeriodic()        // domain is periodic in all directions
-                && ba.size() == 1 && lev == 0, // domain is decomposed in a single box
-                "The option `psatd.periodic_single_box_fft` can only be used for a periodic domain, decomposed in a single box");
+                && (ba.size() == 1 || fft_distributed) && lev == 0, // single box, unless distributed FFTs
+                "The option `psatd.periodic_single_box_fft` can only be used for a periodic domain, decomposed in a single box"
+                " (or in several boxes with `psatd.distributed_fft`)");
 #   endif
         }
         // Get the cell-centered box
@@ -2844,6 +3052,9 @@ WarpX::AllocLevelMFs (int lev, const BoxArray& ba, const DistributionMapping& dm
     if (load_balance_intervals.isActivated())
     {
         costs[lev] = std::make_unique<LayoutData<Real>>(ba, dm);
+        if (load_balance_particles_only) {
+            particle_costs[lev] = std::make_unique<LayoutData<Real>>(ba, dm);
+        }
         load_balance_efficiency[lev] = -1;
     }
 }
@@ -2937,14 +3148,19 @@ void WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolv
                                                 solver_dt,
                                                 pml_flag,
                                                 fft_periodic_single_box,
+                                                fft_distributed,
                                                 update_with_rho,
                                                 fft_do_time_averaging,
                                                 psatd_solution_type,
                                                 J_in_time,
                                                 rho_in_time,
                                                 do_dive_cleaning,
-                                                do_divb_cleaning);
+                                                do_divb_cleaning,
+                                                fft_on_the_fly_coefficients);
     spectral_solver[lev] = std::move(pss);
+
+    // the new spectral fields are empty
+    if (!pml_flag) { m_psatd_spectral_fields_current = false; }
 }
 #   endif
 #endif
@@ -3148,6 +3364,99 @@ WarpX::getCosts (int lev)
     }
 }
 
+amrex::LayoutData<amrex::Real>*
+WarpX::getParticleCosts (int lev)
+{
+    if (m_instance)
+    {
+        return (m_instance->load_balance_particles_only)
+            ? m_instance->particle_costs[lev].get()
+            : m_instance->costs[lev].get();
+    } else
+    {
+        return nullptr;
+    }
+}
+
+bool
+WarpX::ParticlesOnFieldGrids (int lev) const
+{
+    if (!load_balance_particles_only || mypc->nContainers() == 0) { return true; }
+    return mypc->GetParticleContainer(0).ParticleDistributionMap(lev) == DistributionMap(lev);
+}
+
+std::unique_ptr<amrex::MultiFab>
+WarpX::CopyToParticleGrids (int lev, amrex::MultiFab const& mf, bool copy_data) const
+{
+    const amrex::DistributionMapping& dm =
+        mypc->GetParticleContainer(0).ParticleDistributionMap(lev);
+    auto copy = std::make_unique<amrex::MultiFab>(
+        mf.boxArray(), dm, mf.nComp(), mf.nGrowVect());
+    if (copy_data)
+    {
+        // the boxes are the same, so this only sends each box (with its guard cells)
+        // from its owner on the fields to its owner on the particles
+        copy->Redistribute(mf, 0, 0, mf.nComp(), mf.nGrowVect());
+    }
+    return copy;
+}
+
+std::array<std::unique_ptr<amrex::MultiFab>, 3>
+WarpX::CopyToParticleGrids (int lev, std::array<std::unique_ptr<amrex::MultiFab>, 3> const& mf,
+                            bool copy_data) const
+{
+    return {CopyToParticleGrids(lev, *mf[0], copy_data),
+            CopyToParticleGrids(lev, *mf[1], copy_data),
+            CopyToParticleGrids(lev, *mf[2], copy_data)};
+}
+
+void
+WarpX::UpdateAuxOnParticleGrids ()
+{
+    for (int lev = 0; lev <= finest_level; ++lev)
+    {
+        if (ParticlesOnFieldGrids(lev)) {
+            for (int i = 0; i < 3; ++i) {
+                Efield_aux_particle_grids[lev][i].reset();
+                Bfield_aux_particle_grids[lev][i].reset();
+            }
+            continue;
+        }
+        const amrex::DistributionMapping& dm =
+            mypc->GetParticleContainer(0).ParticleDistributionMap(lev);
+        const auto update_copy = [&] (std::unique_ptr<amrex::MultiFab>& copy, amrex::MultiFab const& mf)
+        {
+            // reallocate only after a load balance of the particles
+            if (!copy || !(copy->DistributionMap() == dm)) {
+                copy = CopyToParticleGrids(lev, mf, false);
+            }
+            copy->Redistribute(mf, 0, 0, mf.nComp(), mf.nGrowVect());
+        };
+        for (int i = 0; i < 3; ++i) {
+            update_copy(Efield_aux_particle_grids[lev][i], *Efield_aux[lev][i]);
+            update_copy(Bfield_aux_particle_grids[lev][i], *Bfield_aux[lev][i]);
+        }
+    }
+}
+
+std::array<std::unique_ptr<amrex::MultiFab>, 6>
+WarpX::GetAuxForParticleGather (int lev) const
+{
+    std::array<std::unique_ptr<amrex::MultiFab>, 6> fields;
+    for (int i = 0; i < 3; ++i) {
+        amrex::MultiFab const& E = *Efield_aux[lev][i];
+        amrex::MultiFab const& B = *Bfield_aux[lev][i];
+        if (ParticlesOnFieldGrids(lev)) {
+            fields[i] = std::make_unique<amrex::MultiFab>(E, amrex::make_alias, 0, E.nComp());
+            fields[i+3] = std::make_unique<amrex::MultiFab>(B, amrex::make_alias, 0, B.nComp());
+        } else {
+            fields[i] = CopyToParticleGrids(lev, E);
+            fields[i+3] = CopyToParticleGrids(lev, B);
+        }
+    }
+    return fields;
+}
+
 void
 WarpX::setLoadBalanceEfficiency (const int lev, const amrex::Real efficiency)
 {
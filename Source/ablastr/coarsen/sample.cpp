@@ -10,6 +10,7 @@
 
 #include <AMReX_BLProfiler.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FArrayBox.H>
@@ -20,21 +21,28 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_Vector.H>
 
 #include <memory>
+#include <vector>
 
 
-namespace ablastr::coarsen::sample
+namespace
 {
+    /** Same as ablastr::coarsen::sample::Loop, but the box i of mf_dst is filled
+     *  from the box src_index[i] of mf_src, which must be owned by the same process
+     *  and contain it. An empty src_index means that the boxes have the same indices.
+     */
     void
-    Loop (
+    LoopWithIndexMap (
         amrex::MultiFab& mf_dst,
         const amrex::MultiFab& mf_src,
         const int dcomp,
         const int scomp,
         const int ncomp,
         const amrex::IntVect ngrowvect,
-        const amrex::IntVect crse_ratio
+        const amrex::IntVect crse_ratio,
+        const std::vector<int>& src_index
     )
     {
         // Staggering of source fine MultiFab and destination coarse MultiFab
@@ -69,15 +77,33 @@ namespace ablastr::coarsen::sample
             // Tiles defined at the coarse level
             const amrex::Box& bx = mfi.growntilebox( ngrowvect );
             amrex::Array4<amrex::Real> const& arr_dst = mf_dst.array( mfi );
-            amrex::Array4<amrex::Real const> const& arr_src = mf_src.const_array( mfi );
+            amrex::Array4<amrex::Real const> const& arr_src = src_index.empty() ?
+                mf_src.const_array( mfi ) : mf_src.const_array( src_index[mfi.index()] );
             ParallelFor( bx, ncomp,
                          [=] AMREX_GPU_DEVICE( int i, int j, int k, int n )
                          {
-                             arr_dst(i,j,k,n+dcomp) = Interp(
+                             arr_dst(i,j,k,n+dcomp) = ablastr::coarsen::sample::Interp(
                                 arr_src, sf, sc, cr, i, j, k, n+scomp );
                          } );
         }
     }
+}
+
+namespace ablastr::coarsen::sample
+{
+    void
+    Loop (
+        amrex::MultiFab& mf_dst,
+        const amrex::MultiFab& mf_src,
+        const int dcomp,
+        const int scomp,
+        const int ncomp,
+        const amrex::IntVect ngrowvect,
+        const amrex::IntVect crse_ratio
+    )
+    {
+        LoopWithIndexMap( mf_dst, mf_src, dcomp, scomp, ncomp, ngrowvect, crse_ratio, {} );
+    }
 
     void
     Coarsen (
@@ -121,6 +147,39 @@ namespace ablastr::coarsen::sample
 
         if ( ba_tmp == mf_dst.boxArray() and mf_src.DistributionMap() == mf_dst.DistributionMap() ) {
             Loop( mf_dst, mf_src, dcomp, scomp, ncomp, ngrowvect, crse_ratio );
+            return;
+        }
+
+        // If the destination only covers a region of interest of the source, restrict
+        // the interpolation to the source boxes that intersect it
+        const amrex::Box dst_region = mf_dst.boxArray().minimalBox();
+        if ( !dst_region.contains( ba_tmp.minimalBox() ) )
+        {
+            amrex::BoxList bl_sub( ba_tmp.ixType() );
+            amrex::Vector<int> pmap_sub;
+            std::vector<int> src_index;
+            for (int i = 0; i < static_cast<int>(ba_tmp.size()); ++i) {
+                const amrex::Box b = ba_tmp[i] & dst_region;
+                if ( b.ok() ) {
+                    bl_sub.push_back( b );
+                    pmap_sub.push_back( mf_src.DistributionMap()[i] );
+                    src_index.push_back( i );
+                }
+            }
+            // nothing to interpolate if the region of interest is not covered by the source
+            if ( bl_sub.isEmpty() ) { return; }
+            const amrex::BoxArray ba_sub( std::move(bl_sub) );
+
+            if ( ba_sub == mf_dst.boxArray() and pmap_sub == mf_dst.DistributionMap().ProcessorMap() ) {
+                // Each destination box is contained in a source box owned by the same process:
+                // interpolate directly, without temporary MultiFab nor communication
+                LoopWithIndexMap( mf_dst, mf_src, dcomp, scomp, ncomp, ngrowvect, crse_ratio, src_index );
+            } else {
+                const amrex::DistributionMapping dm_sub( std::move(pmap_sub) );
+                amrex::MultiFab mf_tmp( ba_sub, dm_sub, ncomp, ngrowvect, amrex::MFInfo(), amrex::FArrayBoxFactory() );
+                LoopWithIndexMap( mf_tmp, mf_src, 0, scomp, ncomp, ngrowvect, crse_ratio, src_index );
+                mf_dst.ParallelCopy( mf_tmp, 0, dcomp, ncomp );
+            }
         } else
         {
             // Cannot coarsen into MultiFab with different BoxArray or DistributionMapping:
@@ -28,39 +28,37 @@ namespace ablastr::math::anyfft
     std::string cufftErrorToString (const cufftResult& err);
 
     FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
+                       Complex * const complex_array, const direction dir, const int dim,
+                       const int howmany)
     {
         FFTplan fft_plan;
         ABLASTR_PROFILE("ablastr::math::anyfft::CreatePlan");
 
+        if (dim < 1 || dim > 3) {
+            ABLASTR_ABORT_WITH_MESSAGE("only dim=1 and dim=2 and dim=3 have been implemented");
+        }
+
+        // Swap dimensions: AMReX FAB are Fortran-order but cuFFT is C-order
+        int n[3] = {0, 0, 0};
+        int real_dist = 1;
+        int complex_dist = 1;
+        for (int idim = 0; idim < dim; ++idim) {
+            n[dim-1-idim] = real_size[idim];
+            real_dist *= real_size[idim];
+            complex_dist *= (idim == 0) ? real_size[idim]/2 + 1 : real_size[idim];
+        }
+
         // Initialize fft_plan.m_plan with the vendor fft plan.
+        // The arrays of the batch are contiguous, one after the other.
         cufftResult result;
         if (dir == direction::R2C){
-            if (dim == 3) {
-                result = cufftPlan3d(
-                    &(fft_plan.m_plan), real_size[2], real_size[1], real_size[0], VendorR2C);
-            } else if (dim == 2) {
-                result = cufftPlan2d(
-                    &(fft_plan.m_plan), real_size[1], real_size[0], VendorR2C);
-            } else if (dim == 1) {
-                result = cufftPlan1d(
-                    &(fft_plan.m_plan), real_size[0], VendorR2C, 1);
-            } else {
-                ABLASTR_ABORT_WITH_MESSAGE("only dim=1 and dim=2 and dim=3 have been implemented");
-            }
+            result = cufftPlanMany(
+                &(fft_plan.m_plan), dim, n, nullptr, 1, real_dist,
+                nullptr, 1, complex_dist, VendorR2C, howmany);
         } else {
-            if (dim == 3) {
-                result = cufftPlan3d(
-                    &(fft_plan.m_plan), real_size[2], real_size[1], real_size[0], VendorC2R);
-            } else if (dim == 2) {
-                result = cufftPlan2d(
-                    &(fft_plan.m_plan), real_size[1], real_size[0], VendorC2R);
-            } else if (dim == 1) {
-                result = cufftPlan1d(
-                    &(fft_plan.m_plan), real_size[0], VendorC2R, 1);
-            } else {
-                ABLASTR_ABORT_WITH_MESSAGE("only dim=2 and dim=3 have been implemented");
-            }
+            result = cufftPlanMany(
+                &(fft_plan.m_plan), dim, n, nullptr, 1, complex_dist,
+                nullptr, 1, real_dist, VendorC2R, howmany);
         }
 
         ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(result == CUFFT_SUCCESS,
@@ -71,6 +69,7 @@ namespace ablastr::math::anyfft
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
         fft_plan.m_dim = dim;
+        fft_plan.m_howmany = howmany;
 
         return fft_plan;
     }
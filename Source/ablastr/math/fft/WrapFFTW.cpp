@@ -21,23 +21,16 @@ namespace ablastr::math::anyfft
     void cleanup(){/*nothing to do*/}
 
 #ifdef AMREX_USE_FLOAT
-    const auto VendorCreatePlanR2C3D = fftwf_plan_dft_r2c_3d;
-    const auto VendorCreatePlanC2R3D = fftwf_plan_dft_c2r_3d;
-    const auto VendorCreatePlanR2C2D = fftwf_plan_dft_r2c_2d;
-    const auto VendorCreatePlanC2R2D = fftwf_plan_dft_c2r_2d;
-    const auto VendorCreatePlanR2C1D = fftwf_plan_dft_r2c_1d;
-    const auto VendorCreatePlanC2R1D = fftwf_plan_dft_c2r_1d;
+    const auto VendorCreatePlanR2C = fftwf_plan_many_dft_r2c;
+    const auto VendorCreatePlanC2R = fftwf_plan_many_dft_c2r;
 #else
-    const auto VendorCreatePlanR2C3D = fftw_plan_dft_r2c_3d;
-    const auto VendorCreatePlanC2R3D = fftw_plan_dft_c2r_3d;
-    const auto VendorCreatePlanR2C2D = fftw_plan_dft_r2c_2d;
-    const auto VendorCreatePlanC2R2D = fftw_plan_dft_c2r_2d;
-    const auto VendorCreatePlanR2C1D = fftw_plan_dft_r2c_1d;
-    const auto VendorCreatePlanC2R1D = fftw_plan_dft_c2r_1d;
+    const auto VendorCreatePlanR2C = fftw_plan_many_dft_r2c;
+    const auto VendorCreatePlanC2R = fftw_plan_many_dft_c2r;
 #endif
 
     FFTplan CreatePlan(const amrex::IntVect& real_size, amrex::Real * const real_array,
-                       Complex * const complex_array, const direction dir, const int dim)
+                       Complex * const complex_array, const direction dir, const int dim,
+                       const int howmany)
     {
         FFTplan fft_plan;
 
@@ -51,36 +44,31 @@ namespace ablastr::math::anyfft
 #   endif
 #endif
 
-        // Initialize fft_plan.m_plan with the vendor fft plan.
+        if (dim < 1 || dim > 3) {
+            ABLASTR_ABORT_WITH_MESSAGE(
+                "only dim=1 and dim=2 and dim=3 have been implemented");
+        }
+
         // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
+        int n[3] = {0, 0, 0};
+        int real_dist = 1;
+        int complex_dist = 1;
+        for (int idim = 0; idim < dim; ++idim) {
+            n[dim-1-idim] = real_size[idim];
+            real_dist *= real_size[idim];
+            complex_dist *= (idim == 0) ? real_size[idim]/2 + 1 : real_size[idim];
+        }
+
+        // Initialize fft_plan.m_plan with the vendor fft plan.
+        // The arrays of the batch are contiguous, one after the other.
         if (dir == direction::R2C){
-            if (dim == 3) {
-                fft_plan.m_plan = VendorCreatePlanR2C3D(
-                    real_size[2], real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
-            } else if (dim == 2) {
-                fft_plan.m_plan = VendorCreatePlanR2C2D(
-                    real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
-            } else if (dim == 1) {
-                fft_plan.m_plan = VendorCreatePlanR2C1D(
-                    real_size[0], real_array, complex_array, FFTW_ESTIMATE);
-            } else {
-                ABLASTR_ABORT_WITH_MESSAGE(
-                    "only dim=1 and dim=2 and dim=3 have been implemented");
-            }
+            fft_plan.m_plan = VendorCreatePlanR2C(
+                dim, n, howmany, real_array, nullptr, 1, real_dist,
+                complex_array, nullptr, 1, complex_dist, FFTW_ESTIMATE);
         } else if (dir == direction::C2R){
-            if (dim == 3) {
-                fft_plan.m_plan = VendorCreatePlanC2R3D(
-                    real_size[2], real_size[1], real_size[0], complex_array, real_array, FFTW_ESTIMATE);
-            } else if (dim == 2) {
-                fft_plan.m_plan = VendorCreatePlanC2R2D(
-                    real_size[1], real_size[0], complex_array, real_array, FFTW_ESTIMATE);
-            } else if (dim == 1) {
-                fft_plan.m_plan = VendorCreatePlanC2R1D(
-                    real_size[0], complex_array, real_array, FFTW_ESTIMATE);
-            } else {
-                ABLASTR_ABORT_WITH_MESSAGE(
-                    "only dim=1 and dim=2 and dim=3 have been implemented.");
-            }
+            fft_plan.m_plan = VendorCreatePlanC2R(
+                dim, n, howmany, complex_array, nullptr, 1, complex_dist,
+                real_array, nullptr, 1, real_dist, FFTW_ESTIMATE);
         }
 
         // Store meta-data in fft_plan
@@ -88,6 +76,7 @@ namespace ablastr::math::anyfft
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
         fft_plan.m_dim = dim;
+        fft_plan.m_howmany = howmany;
 
         return fft_plan;
     }
@@ -20,7 +20,8 @@ namespace ablastr::math::anyfft
     void cleanup () {/*nothing to do*/}
 
     FFTplan CreatePlan (const amrex::IntVect& real_size, amrex::Real * const real_array,
-                        Complex * const complex_array, const direction dir, const int dim)
+                        Complex * const complex_array, const direction dir, const int dim,
+                        const int howmany)
     {
         FFTplan fft_plan;
         ABLASTR_PROFILE("ablastr::math::anyfft::CreatePlan");
@@ -56,6 +57,21 @@ namespace ablastr::math::anyfft
                                    DFTI_NOT_INPLACE);
         fft_plan.m_plan->set_value(oneapi::mkl::dft::config_param::FWD_STRIDES,
                                    strides.data());
+        if (howmany > 1) {
+            // The arrays of the batch are contiguous, one after the other
+            std::int64_t real_dist = 1;
+            std::int64_t complex_dist = 1;
+            for (int idim = 0; idim < dim; ++idim) {
+                real_dist *= real_size[idim];
+                complex_dist *= (idim == 0) ? real_size[idim]/2 + 1 : real_size[idim];
+            }
+            fft_plan.m_plan->set_value(oneapi::mkl::dft::config_param::NUMBER_OF_TRANSFORMS,
+                                       std::int64_t(howmany));
+            fft_plan.m_plan->set_value(oneapi::mkl::dft::config_param::FWD_DISTANCE,
+                                       real_dist);
+            fft_plan.m_plan->set_value(oneapi::mkl::dft::config_param::BWD_DISTANCE,
+                                       complex_dist);
+        }
         fft_plan.m_plan->commit(amrex::Gpu::Device::streamQueue());
 
         // Store meta-data in fft_plan
@@ -63,6 +79,7 @@ namespace ablastr::math::anyfft
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
         fft_plan.m_dim = dim;
+        fft_plan.m_howmany = howmany;
         fft_plan.m_stream = amrex::Gpu::gpuStream();
 
         return fft_plan;
@@ -33,7 +33,8 @@ namespace ablastr::math::anyfft
     }
 
     FFTplan CreatePlan (const amrex::IntVect& real_size, amrex::Real * const real_array,
-                        Complex * const complex_array, const direction dir, const int dim)
+                        Complex * const complex_array, const direction dir, const int dim,
+                        const int howmany)
     {
         FFTplan fft_plan;
 
@@ -53,7 +54,7 @@ namespace ablastr::math::anyfft
                                                   rocfft_precision_double,
 #endif
                                                   dim, lengths,
-                                                  1, // number of transforms,
+                                                  howmany, // number of transforms (contiguous)
                                                   nullptr);
         assert_rocfft_status("rocfft_plan_create", result);
 
@@ -62,6 +63,7 @@ namespace ablastr::math::anyfft
         fft_plan.m_complex_array = complex_array;
         fft_plan.m_dir = dir;
         fft_plan.m_dim = dim;
+        fft_plan.m_howmany = howmany;
 
         return fft_plan;
     }
@@ -6,22 +6,214 @@
  */
 #include "Communication.H"
 
+#include <AMReX_Arena.H>
 #include <AMReX_BaseFab.H>
 #include <AMReX_BLProfiler.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_FabArray.H>
 #include <AMReX_FabArrayUtility.H>
 #include <AMReX_FabFactory.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_iMultiFab.H>
 #include <AMReX_IndexType.H>
+#include <AMReX_ParallelDescriptor.H>
 #include <AMReX_ParmParse.H>
+#include <AMReX_TagParallelFor.H>
 
-#include <algorithm>
+#include <map>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 
+namespace
+{
+    /** Whether to synchronize the shared nodes in FillBoundary */
+    bool
+    DoNodalSync (std::optional<bool> nodal_sync)
+    {
+        // allow developers to always enforce nodal sync, independent of the
+        // nodal_sync argument
+        const bool do_nodal_sync_arg = nodal_sync.value_or(false);
+
+        const amrex::ParmParse pp_ablastr("ablastr");
+        bool do_nodal_sync_input = false;
+        pp_ablastr.query("fillboundary_always_sync", do_nodal_sync_input);
+
+        // logic: inputs overwrite argument unless argument is true
+        return do_nodal_sync_arg || do_nodal_sync_input;
+    }
+
+    /** Number of messages sent by the batched FillBoundary of this rank, and number of
+     *  messages that one exchange per MultiFab would have sent */
+    amrex::Long num_batched_messages = 0;
+    amrex::Long num_unbatched_messages = 0;
+
+    /** Region of a MultiFab copied to or from a message buffer */
+    template <typename FabT, typename BufT>
+    struct BufferTag
+    {
+        amrex::Array4<FabT> fab;
+        BufT* buffer;
+        amrex::Box bx;
+
+        [[nodiscard]] AMREX_GPU_HOST_DEVICE
+        amrex::Box const& box () const noexcept { return bx; }
+
+        /** Position in the buffer of the component n of the cell (i,j,k) */
+        [[nodiscard]] AMREX_GPU_HOST_DEVICE
+        amrex::Long index (int i, int j, int k, int n) const noexcept {
+            return n*bx.numPts() + bx.index(amrex::IntVect(AMREX_D_DECL(i,j,k)));
+        }
+    };
+
+    /** Offset in a message buffer and size of the message to (or from) each rank,
+     *  and total size of the buffer */
+    amrex::Long
+    MessageOffsets (ablastr::utils::communication::FillBoundaryRequest const& request,
+                    bool send, std::map<int, amrex::Long>& offsets, std::map<int, amrex::Long>& sizes)
+    {
+        for (std::size_t i = 0; i < request.mf.size(); ++i) {
+            auto const& tags = send ? *request.fb[i]->m_SndTags : *request.fb[i]->m_RcvTags;
+            for (auto const& [rank, rank_tags] : tags) {
+                for (auto const& tag : rank_tags) {
+                    sizes[rank] += tag.sbox.numPts() * request.mf[i]->nComp();
+                }
+            }
+        }
+        amrex::Long total = 0;
+        for (auto const& [rank, size] : sizes) {
+            offsets[rank] = total;
+            total += size;
+        }
+        return total;
+    }
+
+    /** Copy the local guard cells, pack the guard-cell regions of all the MultiFabs in
+     *  one buffer per neighbor rank, and post one message per neighbor rank */
+    template <typename T>
+    void
+    PostFillBoundary (ablastr::utils::communication::FillBoundaryRequest& request)
+    {
+        for (std::size_t i = 0; i < request.mf.size(); ++i) {
+            auto& mf = *request.mf[i];
+            amrex::Vector<amrex::Array4CopyTag<amrex::Real>> loc_tags;
+            for (auto const& tag : *request.fb[i]->m_LocTags) {
+                loc_tags.push_back({mf.array(tag.dstIndex), mf.const_array(tag.srcIndex), tag.dbox,
+                                    (tag.sbox.smallEnd() - tag.dbox.smallEnd()).dim3()});
+            }
+            if (!loc_tags.empty()) {
+                amrex::ParallelFor(loc_tags, mf.nComp(),
+                    [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, int n,
+                                          amrex::Array4CopyTag<amrex::Real> const& tag) noexcept
+                    {
+                        tag.dfab(ii,jj,kk,n) = tag.sfab(ii+tag.offset.x, jj+tag.offset.y, kk+tag.offset.z, n);
+                    });
+            }
+        }
+
+#ifdef AMREX_USE_MPI
+        if (amrex::ParallelDescriptor::NProcs() == 1) { return; }
+
+        std::map<int, amrex::Long> send_offsets, send_sizes, recv_offsets, recv_sizes;
+        amrex::Long const send_size = MessageOffsets(request, true, send_offsets, send_sizes);
+        amrex::Long const recv_size = MessageOffsets(request, false, recv_offsets, recv_sizes);
+        request.send_buffer = (send_size > 0) ?
+            static_cast<char*>(amrex::The_Comms_Arena()->alloc(send_size*sizeof(T))) : nullptr;
+        request.recv_buffer = (recv_size > 0) ?
+            static_cast<char*>(amrex::The_Comms_Arena()->alloc(recv_size*sizeof(T))) : nullptr;
+        auto* const send_buffer = reinterpret_cast<T*>(request.send_buffer);
+        auto* const recv_buffer = reinterpret_cast<T*>(request.recv_buffer);
+
+        int const seq_num = amrex::ParallelDescriptor::SeqNum();
+        MPI_Comm const comm = amrex::ParallelDescriptor::Communicator();
+        for (auto const& [rank, offset] : recv_offsets) {
+            request.recv_requests.push_back(amrex::ParallelDescriptor::Arecv(
+                recv_buffer + offset, recv_sizes[rank], rank, seq_num, comm).req());
+        }
+
+        // pack the regions sent to each rank, MultiFab after MultiFab, in the order of
+        // the tags, which is the order of the tags of the receiving rank
+        std::map<int, amrex::Long> pos = send_offsets;
+        for (std::size_t i = 0; i < request.mf.size(); ++i) {
+            auto const& mf = *request.mf[i];
+            amrex::Vector<BufferTag<amrex::Real const, T>> pack_tags;
+            for (auto const& [rank, rank_tags] : *request.fb[i]->m_SndTags) {
+                for (auto const& tag : rank_tags) {
+                    pack_tags.push_back({mf.const_array(tag.srcIndex), send_buffer + pos[rank], tag.sbox});
+                    pos[rank] += tag.sbox.numPts() * mf.nComp();
+                }
+            }
+            num_unbatched_messages += static_cast<amrex::Long>(request.fb[i]->m_SndTags->size());
+            if (pack_tags.empty()) { continue; }
+            amrex::ParallelFor(pack_tags, mf.nComp(),
+                [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, int n,
+                                      BufferTag<amrex::Real const, T> const& tag) noexcept
+                {
+                    tag.buffer[tag.index(ii,jj,kk,n)] = static_cast<T>(tag.fab(ii,jj,kk,n));
+                });
+        }
+        amrex::Gpu::streamSynchronize();
+
+        for (auto const& [rank, offset] : send_offsets) {
+            request.send_requests.push_back(amrex::ParallelDescriptor::Asend(
+                send_buffer + offset, send_sizes[rank], rank, seq_num, comm).req());
+        }
+        num_batched_messages += static_cast<amrex::Long>(send_offsets.size());
+#endif
+    }
+
+    /** Wait for the messages and unpack them in the guard cells */
+    template <typename T>
+    void
+    FinishFillBoundary (ablastr::utils::communication::FillBoundaryRequest& request)
+    {
+#ifdef AMREX_USE_MPI
+        if (!request.recv_requests.empty()) {
+            amrex::Vector<MPI_Status> stats(request.recv_requests.size());
+            amrex::ParallelDescriptor::Waitall(request.recv_requests, stats);
+        }
+
+        auto* const recv_buffer = reinterpret_cast<T*>(request.recv_buffer);
+        std::map<int, amrex::Long> pos, recv_sizes;
+        MessageOffsets(request, false, pos, recv_sizes);
+        for (std::size_t i = 0; i < request.mf.size(); ++i) {
+            auto& mf = *request.mf[i];
+            amrex::Vector<BufferTag<amrex::Real, T const>> unpack_tags;
+            for (auto const& [rank, rank_tags] : *request.fb[i]->m_RcvTags) {
+                for (auto const& tag : rank_tags) {
+                    unpack_tags.push_back({mf.array(tag.dstIndex), recv_buffer + pos[rank], tag.dbox});
+                    pos[rank] += tag.dbox.numPts() * mf.nComp();
+                }
+            }
+            if (unpack_tags.empty()) { continue; }
+            amrex::ParallelFor(unpack_tags, mf.nComp(),
+                [=] AMREX_GPU_DEVICE (int ii, int jj, int kk, int n,
+                                      BufferTag<amrex::Real, T const> const& tag) noexcept
+                {
+                    tag.fab(ii,jj,kk,n) = static_cast<amrex::Real>(tag.buffer[tag.index(ii,jj,kk,n)]);
+                });
+        }
+        amrex::Gpu::streamSynchronize();
+
+        if (!request.send_requests.empty()) {
+            amrex::Vector<MPI_Status> stats(request.send_requests.size());
+            amrex::ParallelDescriptor::Waitall(request.send_requests, stats);
+        }
+        if (request.send_buffer) { amrex::The_Comms_Arena()->free(request.send_buffer); }
+        if (request.recv_buffer) { amrex::The_Comms_Arena()->free(request.recv_buffer); }
+        request.send_buffer = nullptr;
+        request.recv_buffer = nullptr;
+        request.send_requests.clear();
+        request.recv_requests.clear();
+#endif
+        request.fb.clear();
+    }
+}
+
 namespace ablastr::utils::communication
 {
 
@@ -76,16 +268,7 @@ void FillBoundary (amrex::MultiFab &mf,
 {
     BL_PROFILE("ablastr::utils::communication::FillBoundary");
 
-    // allow developers to always enforce nodal sync, independent of the
-    // nodal_sync argument
-    const bool do_nodal_sync_arg = nodal_sync.value_or(false);
-
-    const amrex::ParmParse pp_ablastr("ablastr");
-    bool do_nodal_sync_input = false;
-    pp_ablastr.query("fillboundary_always_sync", do_nodal_sync_input);
-
-    // logic: inputs overwrite argument unless argument is true
-    bool const do_nodal_sync = do_nodal_sync_arg || do_nodal_sync_input;
+    bool const do_nodal_sync = DoNodalSync(nodal_sync);
 
     if (do_single_precision_comms)
     {
@@ -124,11 +307,84 @@ void
 FillBoundary (amrex::Vector<amrex::MultiFab *> const &mf, bool do_single_precision_comms,
              const amrex::Periodicity &period, std::optional<bool> nodal_sync)
 {
-    for (auto *x : mf) {
-        ablastr::utils::communication::FillBoundary(*x, do_single_precision_comms, period, nodal_sync);
+    amrex::Vector<amrex::IntVect> ng;
+    ng.reserve(mf.size());
+    for (auto const *x : mf) { ng.push_back(x->nGrowVect()); }
+    ablastr::utils::communication::FillBoundary(mf, ng, do_single_precision_comms, period, nodal_sync);
+}
+
+void
+FillBoundary (amrex::Vector<amrex::MultiFab *> const &mf,
+              amrex::Vector<amrex::IntVect> const &ng,
+              bool do_single_precision_comms,
+              const amrex::Periodicity &period,
+              std::optional<bool> nodal_sync)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary::batched");
+
+    auto request = FillBoundary_nowait(mf, ng, do_single_precision_comms, period, nodal_sync);
+    FillBoundary_finish(request);
+}
+
+FillBoundaryRequest
+FillBoundary_nowait (amrex::Vector<amrex::MultiFab *> const &mf,
+                     amrex::Vector<amrex::IntVect> const &ng,
+                     bool do_single_precision_comms,
+                     const amrex::Periodicity &period,
+                     std::optional<bool> nodal_sync)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary_nowait");
+
+    AMREX_ALWAYS_ASSERT(mf.size() == ng.size());
+
+    FillBoundaryRequest request;
+    request.do_single_precision_comms = do_single_precision_comms;
+
+    // The synchronization of the shared nodes is done by AMReX, one MultiFab at a time,
+    // and is completed here
+    if (DoNodalSync(nodal_sync)) {
+        for (int i = 0; i < static_cast<int>(mf.size()); ++i) {
+            ablastr::utils::communication::FillBoundary(*mf[i], ng[i], do_single_precision_comms,
+                                                        period, true);
+        }
+        return request;
+    }
+
+    request.mf = mf;
+    request.ng = ng;
+    for (int i = 0; i < static_cast<int>(mf.size()); ++i) {
+        AMREX_ALWAYS_ASSERT(ng[i].allLE(mf[i]->nGrowVect()));
+        request.fb.push_back(&mf[i]->getFB(ng[i], period));
+    }
+
+    if (do_single_precision_comms) {
+        PostFillBoundary<comm_float_type>(request);
+    } else {
+        PostFillBoundary<amrex::Real>(request);
+    }
+    return request;
+}
+
+void
+FillBoundary_finish (FillBoundaryRequest &request)
+{
+    BL_PROFILE("ablastr::utils::communication::FillBoundary_finish");
+
+    if (request.fb.empty()) { return; }
+
+    if (request.do_single_precision_comms) {
+        FinishFillBoundary<comm_float_type>(request);
+    } else {
+        FinishFillBoundary<amrex::Real>(request);
     }
 }
 
+std::pair<amrex::Long, amrex::Long>
+FillBoundaryMessageCounts ()
+{
+    return {num_batched_messages, num_unbatched_messages};
+}
+
 void FillBoundary (amrex::iMultiFab &imf, const amrex::Periodicity &period)
 {
     BL_PROFILE("ablastr::utils::communication::FillBoundary::iMultiFab");
@@ -156,21 +412,70 @@ SumBoundary (amrex::MultiFab &mf,
 {
     BL_PROFILE("ablastr::utils::communication::SumBoundary");
 
+    auto request = SumBoundary_nowait(mf, start_comp, num_comps, src_ng, dst_ng,
+                                      do_single_precision_comms, period);
+    SumBoundary_finish(request);
+}
+
+SumBoundaryRequest
+SumBoundary_nowait (amrex::MultiFab &mf,
+                    int start_comp,
+                    int num_comps,
+                    amrex::IntVect src_ng,
+                    amrex::IntVect dst_ng,
+                    bool do_single_precision_comms,
+                    const amrex::Periodicity &period)
+{
+    BL_PROFILE("ablastr::utils::communication::SumBoundary_nowait");
+
+    SumBoundaryRequest request;
+    request.mf = &mf;
+    request.start_comp = start_comp;
+    request.num_comps = num_comps;
+    request.dst_ng = dst_ng;
+
     if (do_single_precision_comms)
     {
-        amrex::FabArray<amrex::BaseFab<comm_float_type> > mf_tmp(mf.boxArray(),
-                                                                 mf.DistributionMap(),
-                                                                 num_comps,
-                                                                 mf.nGrowVect());
-        mixedCopy(mf_tmp, mf, start_comp, 0, num_comps, mf.nGrowVect());
+        request.tmp_float = std::make_unique<amrex::FabArray<amrex::BaseFab<comm_float_type>>>(
+            mf.boxArray(), mf.DistributionMap(), num_comps, mf.nGrowVect());
+        mixedCopy(*request.tmp_float, mf, start_comp, 0, num_comps, mf.nGrowVect());
 
-        mf_tmp.SumBoundary(0, num_comps, src_ng, dst_ng, period);
+        // the summed values are added back at the end, so that mf can be added to
+        // in the meantime
+        mf.setVal(0., start_comp, num_comps, dst_ng);
 
-        mixedCopy(mf, mf_tmp, 0, start_comp, num_comps, dst_ng);
+        request.tmp_float->SumBoundary_nowait(0, num_comps, src_ng, dst_ng, period);
+    }
+    else
+    {
+        mf.SumBoundary_nowait(start_comp, num_comps, src_ng, dst_ng, period);
+    }
+    return request;
+}
+
+void
+SumBoundary_finish (SumBoundaryRequest &request)
+{
+    BL_PROFILE("ablastr::utils::communication::SumBoundary_finish");
+
+    if (request.tmp_float)
+    {
+        request.tmp_float->SumBoundary_finish();
+
+        auto const& dst = request.mf->arrays();
+        auto const& src = request.tmp_float->const_arrays();
+        int const start_comp = request.start_comp;
+        amrex::ParallelFor(*request.mf, request.dst_ng, request.num_comps,
+            [=] AMREX_GPU_DEVICE (int bno, int i, int j, int k, int n) noexcept
+            {
+                dst[bno](i,j,k,start_comp+n) += static_cast<amrex::Real>(src[bno](i,j,k,n));
+            });
+        amrex::Gpu::streamSynchronize();
+        request.tmp_float.reset();
     }
     else
     {
-        mf.SumBoundary(start_comp, num_comps, src_ng, dst_ng, period);
+        request.mf->SumBoundary_finish();
     }
 }
 
@@ -0,0 +1,203 @@
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+Consumer of the WarpX ``stream`` diagnostics format (in-transit analysis).
+
+The layout of the messages and of the shared-memory ring buffer is documented in
+Source/Diagnostics/FlushFormats/FlushFormatStream.H. Every MPI rank of WarpX
+publishes to its own endpoint, ``<name>_<rank>``.
+
+Example, reading the shared-memory ring buffer of rank 0:
+
+    ring = ShmRing("warpx_diag1_0")
+    for message in ring.messages():
+        print(message["iteration"], message["fields"][0]["boxes"][0]["data"]["Ex"])
+    ring.unlink()
+"""
+
+import mmap
+import os
+import socket
+import struct
+import time
+
+import numpy as np
+
+RING_HEADER_SIZE = 64
+# offsets of the fields of the ring buffer header
+_MAGIC, _VERSION, _RING_SIZE, _SLOT_SIZE, _HEAD, _TAIL, _CLOSED = 0, 8, 12, 16, 24, 32, 40
+
+
+class _Reader:
+    def __init__(self, buf):
+        self.buf = buf
+        self.pos = 0
+
+    def unpack(self, fmt):
+        values = struct.unpack_from("=" + fmt, self.buf, self.pos)
+        self.pos += struct.calcsize("=" + fmt)
+        return values if len(values) > 1 else values[0]
+
+    def string(self):
+        n = self.unpack("I")
+        s = bytes(self.buf[self.pos : self.pos + n]).decode()
+        self.pos += n
+        return s
+
+    def array(self, dtype, count):
+        a = np.frombuffer(self.buf, dtype=dtype, count=count, offset=self.pos).copy()
+        self.pos += a.nbytes
+        return a
+
+
+def parse_message(buf):
+    """
+    Decode one message (without its leading size field) into a dictionary.
+
+    The fields are returned per level as a list of boxes, each with ``lo``, ``hi``
+    and ``data``, a dictionary of arrays indexed as [i, j, k].
+    The particles are returned as a dictionary of species, each a dictionary of arrays.
+    """
+    r = _Reader(buf)
+    magic = bytes(r.buf[0:8])
+    r.pos = 8
+    if magic != b"WARPXSTM":
+        raise ValueError("Not a WarpX stream message")
+    message = {}
+    message["version"] = r.unpack("I")
+    real = np.float32 if r.unpack("I") == 4 else np.float64
+    particle_real = np.float32 if r.unpack("I") == 4 else np.float64
+    message["rank"], message["nranks"] = r.unpack("ii")
+    message["iteration"] = r.unpack("q")
+    message["time"] = r.unpack("d")
+    dim = r.unpack("i")
+    nlev = r.unpack("i")
+    ncomp = r.unpack("i")
+    varnames = [r.string() for _ in range(ncomp)]
+    message["fields"] = []
+    for _ in range(nlev):
+        level = {}
+        level["prob_lo"] = r.unpack(dim * "d")
+        level["prob_hi"] = r.unpack(dim * "d")
+        level["domain_lo"] = r.unpack(dim * "i")
+        level["domain_hi"] = r.unpack(dim * "i")
+        level["boxes"] = []
+        for _ in range(r.unpack("i")):
+            lo = np.atleast_1d(r.unpack(dim * "i"))
+            hi = np.atleast_1d(r.unpack(dim * "i"))
+            shape = tuple(hi - lo + 1)
+            ncells = int(np.prod(shape))
+            data = {}
+            for name in varnames:
+                data[name] = r.array(real, ncells).reshape(shape, order="F")
+            level["boxes"].append({"lo": lo, "hi": hi, "data": data})
+        message["fields"].append(level)
+    message["particles"] = {}
+    for _ in range(r.unpack("i")):
+        species = {}
+        name = r.string()
+        np_ = r.unpack("q")
+        real_names = [r.string() for _ in range(r.unpack("i"))]
+        int_names = [r.string() for _ in range(r.unpack("i"))]
+        for rname in real_names:
+            species[rname] = r.array(particle_real, np_)
+        idcpu = r.array(np.uint64, np_)
+        species["id"] = (idcpu >> np.uint64(24)).astype(np.int64)
+        species["cpu"] = (idcpu & np.uint64(0xFFFFFF)).astype(np.int64)
+        for iname in int_names:
+            species[iname] = r.array(np.int32, np_)
+        message["particles"][name] = species
+    return message
+
+
+class ShmRing:
+    """
+    Reader of the shared-memory ring buffer of one rank.
+
+    The shared-memory object is created by WarpX at the first flush and is not removed
+    at the end of the simulation: call unlink() once all the messages are consumed.
+    """
+
+    def __init__(self, name, timeout=60.0):
+        self.path = "/dev/shm/" + name.lstrip("/")
+        start = time.time()
+        while True:
+            if os.path.exists(self.path):
+                fd = os.open(self.path, os.O_RDWR)
+                size = os.fstat(fd).st_size
+                if size >= RING_HEADER_SIZE:
+                    self.map = mmap.mmap(fd, size)
+                    os.close(fd)
+                    if self.map[_MAGIC : _MAGIC + 8] == b"WARPXRNG":
+                        break
+                    self.map.close()
+                else:
+                    os.close(fd)
+            if time.time() - start > timeout:
+                raise TimeoutError("No WarpX ring buffer at " + self.path)
+            time.sleep(0.1)
+        self.ring_size = struct.unpack_from("=I", self.map, _RING_SIZE)[0]
+        self.slot_size = struct.unpack_from("=Q", self.map, _SLOT_SIZE)[0]
+
+    def _load(self, offset, fmt="=Q"):
+        return struct.unpack_from(fmt, self.map, offset)[0]
+
+    def messages(self, poll=1.0e-3):
+        """Yield the messages until WarpX closes the ring buffer and all are consumed"""
+        while True:
+            tail = self._load(_TAIL)
+            closed = self._load(_CLOSED, "=I")
+            if tail == self._load(_HEAD):
+                if closed:
+                    return
+                time.sleep(poll)
+                continue
+            slot = RING_HEADER_SIZE + (tail % self.ring_size) * self.slot_size
+            size = struct.unpack_from("=Q", self.map, slot)[0]
+            buf = bytes(self.map[slot + 8 : slot + 8 + size])
+            # release the slot before parsing, so that WarpX can reuse it
+            struct.pack_into("=Q", self.map, _TAIL, tail + 1)
+            yield parse_message(buf)
+
+    def unlink(self):
+        self.map.close()
+        os.unlink(self.path)
+
+
+def socket_messages(path):
+    """Listen on the Unix-domain socket ``path`` and yield the messages of one rank"""
+    if os.path.exists(path):
+        os.unlink(path)
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(path)
+    server.listen(1)
+    conn, _ = server.accept()
+
+    def recv_exactly(n):
+        buf = bytearray(n)
+        view = memoryview(buf)
+        received = 0
+        while received < n:
+            k = conn.recv_into(view[received:], n - received)
+            if k == 0:
+                return None
+            received += k
+        return buf
+
+    try:
+        while True:
+            header = recv_exactly(8)
+            if header is None:
+                return
+            buf = recv_exactly(struct.unpack("=Q", header)[0])
+            if buf is None:
+                return
+            yield parse_message(buf)
+    finally:
+        conn.close()
+        server.close()
+        os.unlink(path)